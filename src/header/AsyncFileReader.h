@@ -0,0 +1,587 @@
+/**
+ * @file AsyncFileReader.h
+ * @brief This header file contains the class definition of a file reader engine which streams a file into a byte
+ * stream of a dynamic buffer with a queue of asynchronous reads (io_uring or a pool of `pread` threads).
+ *
+ * @author Rakesh Kumar
+ */
+
+#pragma once
+
+#ifndef ASYNC_FILE_READER_H
+#define ASYNC_FILE_READER_H
+
+#include "DynamicBuffer.h"
+#include "IoUring.h"
+
+#if defined(__linux__)
+
+#include <fcntl.h>					// For open, fcntl, O_DIRECT
+#include <unistd.h>					// For pread, read, lseek, close
+#include <cerrno>					// For errno
+#include <cstring>					// For std::strerror, std::memcpy
+#include <cstddef>					// For std::byte
+#include <cstdint>					// For std::uint64_t
+#include <new>						// For std::align_val_t, the staging buffers of direct reads
+#include <atomic>					// For std::atomic
+#include <thread>					// For std::thread, the engine and the pool threads
+#include <mutex>					// For std::mutex
+#include <condition_variable>		// For std::condition_variable, the queues of the pool
+#include <deque>					// For std::deque, the queues of the pool
+#include <vector>					// For std::vector
+#include <memory>					// For std::unique_ptr
+#include <span>						// For std::span, the room left in the last buffer segment
+#include <exception>				// For std::exception_ptr, passing the failure of the engine to `wait()`
+#include <stdexcept>				// For std::runtime_error
+#include <string>					// For std::string
+#include <chrono>					// For std::chrono::milliseconds, the waits for memory
+
+/**
+* @brief Streams a file (a regular file, a block device, a pipe, ...) into the byte stream of a writer of a dynamic
+* buffer, for the files which cannot be mapped (see `MappedFileSource`).
+*
+* An engine thread keeps up to `queueDepth` reads in flight, each one straight into the `items` array of its own
+* buffer segment provided by `DynBuffer::reserveSegment()`. The reads complete in any order but their buffer segments
+* are appended to the writer's stream (`DynBuffer::commitSegment()`) in the order of the file. The reads are submitted
+* to io_uring, or to a pool of `queueDepth` threads calling `pread` when io_uring is not available.
+*
+* Files which cannot be seeked (pipes, sockets, terminals) are read one read at a time into the room left at the end
+* of the writer's last buffer segment (`DynBuffer::reserveAvailable()`), a new buffer segment being started only once
+* it is full, and whatever a read returned is published right away. A short read of a seekable file is continued until
+* its buffer segment is full or the end of the file is reached.
+*
+* While reads are in flight or waiting to be published, buffer segments are only taken within the memory budget
+* (`DynBuffer::tryReserveSegment()`): the engine waits for memory (or applies the overflow policy) only once everything
+* it has read is in the buffer, since memory can only be freed by the readers of what it has published.
+*
+* Descriptors opened with `O_DIRECT` are read into a staging buffer per read aligned to `DIRECT_IO_ALIGNMENT`, since
+* the `items` array of a buffer segment is aligned to a cache line only, and copied to the buffer segment as the read
+* completes. The reads of a seekable file are then `segmentBytes` rounded up to a multiple of `DIRECT_IO_ALIGNMENT`.
+*
+* @tparam Policy The policy of the buffer (see `BufferPolicy`).
+*/
+template <typename Policy = BufferPolicy<>> class AsyncFileReader {
+
+public:
+
+	// The alignment of the memory, the offsets and the lengths of direct (`O_DIRECT`) reads
+	static constexpr unsigned long long DIRECT_IO_ALIGNMENT = 4096;
+
+	/**
+	* @brief Constructor, starts reading the file at `path`.
+	*
+	* @param buffer The buffer the file is read into.
+	* @param pOwner Pointer to the owner with write access the file is read for.
+	* @param path The path of the file.
+	* @param segmentBytes The number of bytes read into a buffer segment.
+	* @param queueDepth The maximum number of reads in flight.
+	* @param backend Where the reads are submitted to.
+	*/
+	AsyncFileReader(
+		DynBuffer<std::byte, Policy>& buffer,
+		BufferSegmentOwner* pOwner,
+		const std::string& path,
+		unsigned long long segmentBytes = 1ULL << 20,
+		unsigned queueDepth = 8,
+		FILE_IO_BACKEND backend = FILE_IO_BACKEND::AUTO
+	) : AsyncFileReader(buffer, pOwner, openFile(path), true, segmentBytes, queueDepth, backend) {}
+
+	/**
+	* @brief Constructor, starts reading from the file descriptor `fd` (from its current position if it cannot be
+	* seeked, from its start otherwise). The descriptor is not closed by the reader, nor are its flags changed.
+	*
+	* @param buffer The buffer the file is read into.
+	* @param pOwner Pointer to the owner with write access the file is read for.
+	* @param fd The file descriptor, open for reading.
+	* @param segmentBytes The number of bytes read into a buffer segment.
+	* @param queueDepth The maximum number of reads in flight.
+	* @param backend Where the reads are submitted to.
+	*/
+	AsyncFileReader(
+		DynBuffer<std::byte, Policy>& buffer,
+		BufferSegmentOwner* pOwner,
+		int fd,
+		unsigned long long segmentBytes = 1ULL << 20,
+		unsigned queueDepth = 8,
+		FILE_IO_BACKEND backend = FILE_IO_BACKEND::AUTO
+	) : AsyncFileReader(buffer, pOwner, fd, false, segmentBytes, queueDepth, backend) {}
+
+	/**
+	* @brief Destructor, stops the engine (the reads in flight are waited for) and closes the file if the reader
+	* opened it.
+	*/
+	~AsyncFileReader() {
+		stop();
+		if (engine.joinable()) {
+			engine.join();
+		}
+		stopPool();
+		releaseStaging();
+		if (ownsFd) {
+			::close(fd);
+		}
+	}
+
+	AsyncFileReader(const AsyncFileReader&) = delete;
+	AsyncFileReader& operator=(const AsyncFileReader&) = delete;
+
+	/**
+	* @brief Blocks until the whole file has been read into the buffer (or the reader was stopped).
+	*
+	* @throws std::runtime_error if a read failed, the items of the file before it are in the buffer.
+	*/
+	void wait() {
+		{
+			std::unique_lock<std::mutex> lock(stateMutex);
+			stateChanged.wait(lock, [this]() { return finished; });
+		}
+		if (failure) {
+			std::rethrow_exception(failure);
+		}
+	}
+
+	/**
+	* @brief Stops submitting reads. The reads in flight are completed and their items published.
+	*/
+	void stop() {
+		stopping.store(true, std::memory_order_release);
+	}
+
+	/**
+	* @brief Check if the reader is done, at the end of the file, stopped or failed.
+	*/
+	bool isFinished() {
+		std::lock_guard<std::mutex> lock(stateMutex);
+		return finished;
+	}
+
+	/**
+	* @brief Get the number of bytes of the file published to the buffer so far.
+	*/
+	unsigned long long getBytesRead() const {
+		return bytesRead.load(std::memory_order_acquire);
+	}
+
+	/**
+	* @brief Get the backend the reads are submitted to, `FILE_IO_BACKEND::IO_URING` or `FILE_IO_BACKEND::THREAD_POOL`.
+	*/
+	FILE_IO_BACKEND getBackend() const {
+		return ring ? FILE_IO_BACKEND::IO_URING : FILE_IO_BACKEND::THREAD_POOL;
+	}
+
+private:
+
+	/**
+	* @brief A read in flight, into its own buffer segment or the room reserved at the end of the writer's last one.
+	*/
+	struct Read {
+		BufferSegment<std::byte>* bufferSeg{ nullptr };		// The buffer segment read into, nullptr for `inTail`
+		std::byte* items{ nullptr };						// Where the read starts
+		bool inTail{ false };								// Into the reservation of `DynBuffer::reserveAvailable()`
+		unsigned long long offset{ 0 };						// The offset of the read in the file
+		unsigned long long filled{ 0 };						// The bytes read so far
+		unsigned long long requested{ 0 };					// The bytes to be read
+		bool inFlight{ false };								// Submitted and not completed yet
+		bool done{ false };									// The bytes read can be published
+		bool endOfFile{ false };							// The end of the file was reached by this read
+	};
+
+	DynBuffer<std::byte, Policy>& buffer;				// The buffer the file is read into
+	BufferSegmentOwner* pOwner{ nullptr };				// The writer the file is read for
+	int fd{ -1 };										// The file descriptor
+	bool ownsFd{ false };								// The reader opened the file and closes it
+	bool seekable{ true };								// Reads are at explicit offsets (`pread`), not the file position
+	bool directIo{ false };								// The descriptor was opened with `O_DIRECT`
+	unsigned long long segmentBytes{ 0 };				// The bytes read into a buffer segment
+	unsigned queueDepth{ 0 };							// The maximum number of reads in flight
+	std::vector<Read> reads;							// The reads in flight, the read of sequence `s` at `s % queueDepth`
+	std::vector<std::byte*> staging;					// The staging buffers of direct reads (aligned), one per read
+	std::unique_ptr<IoUring> ring;						// The io_uring the reads are submitted to, if available
+
+	// The pool of `pread` threads, when io_uring is not used
+
+	std::vector<std::thread> pool;
+	std::deque<unsigned long long> pendingReads;		// The sequences of the reads to be made by the pool
+	std::deque<std::pair<unsigned long long, long long>> completedReads;	// (sequence, result) of the reads made
+	std::mutex poolMutex;
+	std::condition_variable readsPending;
+	std::condition_variable readsCompleted;
+	bool poolStopping{ false };
+
+	// The state of the engine
+
+	std::thread engine;
+	std::atomic<bool> stopping{ false };
+	std::atomic<unsigned long long> bytesRead{ 0 };
+	std::exception_ptr failure;							// The failure of the engine, rethrown by `wait()`
+	bool finished{ false };
+	std::mutex stateMutex;
+	std::condition_variable stateChanged;
+
+	AsyncFileReader(
+		DynBuffer<std::byte, Policy>& buffer,
+		BufferSegmentOwner* pOwner,
+		int fd,
+		bool ownsFd,
+		unsigned long long segmentBytes,
+		unsigned queueDepth,
+		FILE_IO_BACKEND backend
+	) : buffer(buffer), pOwner(pOwner), fd(fd), ownsFd(ownsFd), segmentBytes(segmentBytes) {
+		if (pOwner == nullptr || segmentBytes == 0 || segmentBytes > INT_MAX || queueDepth == 0) {
+			if (ownsFd) {
+				::close(fd);
+			}
+			throw std::runtime_error("ERR: INVALID ARGUMENTS OF AN ASYNCHRONOUS FILE READER");
+		}
+		int flags = ::fcntl(fd, F_GETFL);
+		directIo = flags >= 0 && (flags & O_DIRECT) != 0;
+		seekable = ::lseek(fd, 0, SEEK_CUR) >= 0;
+		if (directIo && seekable) {
+			// The offsets and the lengths of direct reads are whole blocks
+			this->segmentBytes = (segmentBytes + DIRECT_IO_ALIGNMENT - 1) / DIRECT_IO_ALIGNMENT * DIRECT_IO_ALIGNMENT;
+		}
+		// The reads of a file which cannot be seeked complete in the order they are made, one at a time
+		this->queueDepth = seekable ? queueDepth : 1;
+		reads.resize(this->queueDepth);
+		if (backend != FILE_IO_BACKEND::THREAD_POOL) {
+			try {
+				ring = std::make_unique<IoUring>(this->queueDepth);
+			}
+			catch (const std::runtime_error&) {
+				if (backend == FILE_IO_BACKEND::IO_URING) {
+					if (ownsFd) {
+						::close(fd);
+					}
+					throw;
+				}
+			}
+		}
+		if (directIo) {
+			try {
+				for (unsigned i = 0; i < this->queueDepth; ++i) {
+					staging.push_back(static_cast<std::byte*>(
+						::operator new(this->segmentBytes, std::align_val_t(DIRECT_IO_ALIGNMENT))
+					));
+				}
+			}
+			catch (...) {
+				releaseStaging();
+				if (ownsFd) {
+					::close(fd);
+				}
+				throw;
+			}
+		}
+		if (!ring) {
+			for (unsigned i = 0; i < this->queueDepth; ++i) {
+				pool.emplace_back([this]() { poolLoop(); });
+			}
+		}
+		engine = std::thread([this]() { engineLoop(); });
+	}
+
+	/**
+	* @brief Opens the file at `path` for reading.
+	*/
+	static int openFile(const std::string& path) {
+		int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (fd < 0) {
+			throw std::runtime_error("ERR: FAILED TO OPEN " + path + " -- " + std::strerror(errno));
+		}
+		return fd;
+	}
+
+	/**
+	* @brief Keeps the queue of reads full and publishes their buffer segments in the order of the file.
+	*/
+	void engineLoop() {
+		unsigned long long submitted = 0;		// The sequence of the next read
+		unsigned long long published = 0;		// The sequence of the next read to be published
+		unsigned long long nextOffset = 0;
+		unsigned long long failedSequence = ~0ULL;	// The sequence of the first read of the file which failed
+		unsigned long long generation = 0;			// The memory generation before the last buffer segment was taken
+		bool endOfFile{ false };
+		try {
+			while (true) {
+				// Fill the queue
+				while (!endOfFile && !failure && !(stopping.load(std::memory_order_acquire)) &&
+					submitted - published < queueDepth) {
+					Read& read = reads[submitted % queueDepth];
+					generation = buffer.getMemoryGeneration();
+					// Wait for memory only with nothing left to publish, the readers free it
+					if (!(prepareRead(read, submitted == published))) {
+						break;		// Over the memory budget, retried once a read completes or memory is released
+					}
+					read.offset = seekable ? nextOffset : bytesRead.load(std::memory_order_relaxed);
+					nextOffset += read.requested;
+					submitRead(submitted);
+					++submitted;
+				}
+				if (submitted == published) {
+					if (endOfFile || failure || stopping.load(std::memory_order_acquire)) {
+						break;
+					}
+					// Nothing in flight since the overflow policy drops the items, wait for the readers to free memory
+					// (`stop()` is checked between the waits)
+					buffer.waitForMemoryReleased(generation, std::chrono::milliseconds(10));
+					continue;
+				}
+
+				unsigned long long sequence{ 0 };
+				long long result = waitRead(sequence);
+				Read& read = reads[sequence % queueDepth];
+				read.inFlight = false;
+				if (result == -EINTR || result == -EAGAIN) {
+					submitRead(sequence);
+					continue;
+				}
+				if (result < 0) {
+					// The reads before it in the file are still published, the failure reported is the first one
+					if (sequence < failedSequence) {
+						failedSequence = sequence;
+						failure = std::make_exception_ptr(std::runtime_error(
+							"ERR: READ OF " + std::to_string(read.requested - read.filled) + " BYTES AT " +
+							std::to_string(read.offset + read.filled) + " FAILED -- " + std::strerror((int)-result)
+						));
+					}
+					read.done = true;
+				}
+				else if (result == 0) {
+					read.endOfFile = true;
+					read.done = true;
+				}
+				else {
+					if (directIo) {
+						std::memcpy(read.items + read.filled, staging[sequence % queueDepth] + read.filled,
+							(unsigned long long)result);
+					}
+					read.filled += (unsigned long long)result;
+					if (seekable && read.filled < read.requested) {
+						if (directIo && read.filled % DIRECT_IO_ALIGNMENT != 0) {
+							// A direct read stops within a block only at the end of the file
+							read.endOfFile = true;
+							read.done = true;
+						}
+						else {
+							submitRead(sequence);		// A short read, continue it
+						}
+					}
+					else {
+						read.done = true;
+					}
+				}
+
+				// Publish the reads completed in the order of the file
+				while (published < submitted && reads[published % queueDepth].done) {
+					Read& next = reads[published % queueDepth];
+					if (endOfFile || published >= failedSequence) {
+						// From the end of the file or the read which failed, nothing more is published
+						giveBack(next);
+					}
+					else {
+						if (next.inTail) {
+							buffer.commit(pOwner, next.filled);
+						}
+						else {
+							buffer.commitSegment(pOwner, next.bufferSeg, next.filled);
+						}
+						next.bufferSeg = nullptr;
+						next.inTail = false;
+						bytesRead.fetch_add(next.filled, std::memory_order_acq_rel);
+						endOfFile = next.endOfFile;
+					}
+					++published;
+				}
+			}
+		}
+		catch (...) {
+			failure = std::current_exception();
+			drain();
+		}
+		std::lock_guard<std::mutex> lock(stateMutex);
+		finished = true;
+		stateChanged.notify_all();
+	}
+
+	/**
+	* @brief Waits for the reads still in flight after a failure of the engine and gives their buffer segments back.
+	*/
+	void drain() {
+		try {
+			for (Read& read : reads) {
+				while (read.inFlight) {
+					unsigned long long sequence{ 0 };
+					waitRead(sequence);
+					reads[sequence % queueDepth].inFlight = false;
+				}
+			}
+		}
+		catch (...) {
+			// The reads cannot be waited for anymore, their buffer segments must not be reused under them
+			return;
+		}
+		for (Read& read : reads) {
+			giveBack(read);
+		}
+	}
+
+	/**
+	* @brief Provides the room the next read is made into: the rest of the writer's last buffer segment for a file
+	* which cannot be seeked (a new buffer segment once it is full), a new buffer segment otherwise.
+	*
+	* @param read The read, reset.
+	* @param mayWait Whether the memory budget may be waited for (the overflow policy applied).
+	* @return false if there is no memory for it.
+	*/
+	bool prepareRead(Read& read, bool mayWait) {
+		read = Read{};
+		if (!seekable) {
+			std::span<std::byte> tail = buffer.reserveAvailable(pOwner, segmentBytes);
+			if (!(tail.empty())) {
+				read.items = tail.data();
+				read.inTail = true;
+				read.requested = tail.size();
+				return true;
+			}
+		}
+		BufferSegment<std::byte>* bufferSeg =
+			mayWait ? buffer.reserveSegment(segmentBytes) : buffer.tryReserveSegment(segmentBytes);
+		if (bufferSeg == nullptr) {
+			return false;
+		}
+		read.bufferSeg = bufferSeg;
+		read.items = bufferSeg->getItems();
+		read.requested = segmentBytes;
+		return true;
+	}
+
+	/**
+	* @brief Gives the room of a read which is not published back to the buffer.
+	*/
+	void giveBack(Read& read) {
+		if (read.inTail) {
+			buffer.commit(pOwner, 0);
+			read.inTail = false;
+		}
+		else if (read.bufferSeg != nullptr) {
+			buffer.cancelSegment(read.bufferSeg);
+			read.bufferSeg = nullptr;
+		}
+	}
+
+	/**
+	* @brief Frees the staging buffers of direct reads.
+	*/
+	void releaseStaging() {
+		for (std::byte* block : staging) {
+			::operator delete(block, std::align_val_t(DIRECT_IO_ALIGNMENT));
+		}
+		staging.clear();
+	}
+
+	/**
+	* @brief Get where (the rest of) the read of sequence `sequence` is made: after what it has filled in its room, or
+	* in its staging buffer for a direct read.
+	*/
+	std::byte* destinationOf(unsigned long long sequence) {
+		Read& read = reads[sequence % queueDepth];
+		return (directIo ? staging[sequence % queueDepth] : read.items) + read.filled;
+	}
+
+	/**
+	* @brief Submits (the rest of) the read of sequence `sequence`.
+	*/
+	void submitRead(unsigned long long sequence) {
+		Read& read = reads[sequence % queueDepth];
+		if (ring) {
+			std::uint64_t offset = seekable ? read.offset + read.filled : (std::uint64_t)-1;
+			if (!(ring->prepare(IORING_OP_READ, fd, destinationOf(sequence),
+				(unsigned)(read.requested - read.filled), offset, sequence))) {
+				throw std::runtime_error("ERR: IO_URING SUBMISSION QUEUE FULL");
+			}
+			read.inFlight = true;
+			ring->submit();
+			return;
+		}
+		{
+			std::lock_guard<std::mutex> lock(poolMutex);
+			pendingReads.push_back(sequence);
+			read.inFlight = true;
+		}
+		readsPending.notify_one();
+	}
+
+	/**
+	* @brief Waits for a read to complete.
+	*
+	* @param sequence The sequence of the completed read.
+	* @return The result of the read, a negated `errno` on failure.
+	*/
+	long long waitRead(unsigned long long& sequence) {
+		if (ring) {
+			std::uint64_t userData{ 0 };
+			int result{ 0 };
+			while (!(ring->popCompletion(userData, result))) {
+				ring->waitCompletion();
+			}
+			sequence = userData;
+			return result;
+		}
+		std::unique_lock<std::mutex> lock(poolMutex);
+		readsCompleted.wait(lock, [this]() { return !(completedReads.empty()); });
+		std::pair<unsigned long long, long long> completion = completedReads.front();
+		completedReads.pop_front();
+		sequence = completion.first;
+		return completion.second;
+	}
+
+	/**
+	* @brief Makes the reads submitted to the pool with blocking `pread` (or `read`) calls.
+	*/
+	void poolLoop() {
+		while (true) {
+			unsigned long long sequence{ 0 };
+			{
+				std::unique_lock<std::mutex> lock(poolMutex);
+				readsPending.wait(lock, [this]() { return poolStopping || !(pendingReads.empty()); });
+				if (pendingReads.empty()) {
+					return;
+				}
+				sequence = pendingReads.front();
+				pendingReads.pop_front();
+			}
+			// The engine does not touch a read while it is in flight
+			Read& read = reads[sequence % queueDepth];
+			std::byte* destination = destinationOf(sequence);
+			unsigned long long length = read.requested - read.filled;
+			ssize_t result = seekable ? ::pread(fd, destination, length, (off_t)(read.offset + read.filled)) :
+				::read(fd, destination, length);
+			long long outcome = result < 0 ? -(long long)errno : (long long)result;
+			{
+				std::lock_guard<std::mutex> lock(poolMutex);
+				completedReads.emplace_back(sequence, outcome);
+			}
+			readsCompleted.notify_one();
+		}
+	}
+
+	/**
+	* @brief Stops the pool threads once the reads submitted to them are made.
+	*/
+	void stopPool() {
+		{
+			std::lock_guard<std::mutex> lock(poolMutex);
+			poolStopping = true;
+		}
+		readsPending.notify_all();
+		for (std::thread& thread : pool) {
+			if (thread.joinable()) {
+				thread.join();
+			}
+		}
+	}
+};
+
+#endif
+
+#endif
@@ -17,7 +17,6 @@
 #include <set>						// For std::set
 #include <list>						// For std::list
 #include <string>					// For std::string
-#include <stdlib.h>					// For malloc
 #include <stdexcept>				// For exceptions
 #include <utility>					// For std::forward
 #include <type_traits>				// For matching template parameters
@@ -27,17 +26,104 @@
 #include <condition_variable>		// For working with conditional variables
 #include <utility>					// For std::pair<T,V> and std::move
 #include <vector>					// For std::vector
-#include <tuple>					// For std::tuple for direct hooks to the buffer
+#include <span>						// For std::span, bulk writes and direct hooks to the buffer
+#include <cstring>					// For std::memcpy
+#include <algorithm>				// For std::min, std::copy
+#include <unordered_map>				// For std::unordered_map, index of buffer segments owned by an owner
+#include <memory>					// For std::unique_ptr, std::construct_at, std::destroy_at, std::destroy_n
+#include <new>						// For std::align_val_t, allocating a buffer segment with its items
+#include <chrono>					// For std::chrono::steady_clock, measuring write rates
+#include <bit>						// For std::bit_ceil
+#include <shared_mutex>				// For std::shared_mutex, lookups on the index of owned buffer segments
 #include <stdexcept>				// For std::exception, std::runtime_error, throwing and handling exceptions
+#include <exception>				// For std::exception_ptr, passing writer worker errors to the producer
+#include <optional>					// For std::optional, non-blocking and timed reads
+#include <cstdint>					// For std::uint32_t, the width of a futex word
+#include <climits>					// For INT_MAX, waking every waiter of a futex word
+#include <cstddef>					// For std::byte, records of a byte stream
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX					// Keep std::min and std::max usable
+#endif
+#include <Windows.h>				// For WaitOnAddress, WakeByAddressAll (parking readers)
+#pragma comment(lib, "Synchronization.lib")
+#elif defined(__linux__)
+#include <linux/futex.h>			// For FUTEX_WAIT_PRIVATE, FUTEX_WAKE_PRIVATE (parking readers)
+#include <linux/membarrier.h>		// For MEMBARRIER_CMD_PRIVATE_EXPEDITED (asymmetric fences)
+#include <sys/syscall.h>			// For SYS_futex
+#include <unistd.h>					// For syscall
+#include <ctime>					// For timespec
+#endif
 
 const int INVALID_ID = 0;
 
+// The size of a cache line, used to keep the state written by different threads apart
+constexpr unsigned long long CACHE_LINE_SIZE = 64;
+
 using ull = unsigned long long;
 
 void debug(std::string msg) {
 	std::cout << msg << std::endl;
 }
 
+/**
+* @brief Tells the processor that the calling thread is spinning.
+*/
+inline void cpuRelax() {
+#if defined(_WIN32)
+	YieldProcessor();
+#elif defined(__x86_64__) || defined(__i386__)
+	__builtin_ia32_pause();
+#else
+	std::this_thread::yield();
+#endif
+}
+
+/**
+* @brief Checks whether the process can issue `asymmetricHeavyFence()`. Registered once, on the first call.
+*/
+inline bool hasAsymmetricFences() {
+#if defined(_WIN32)
+	return true;
+#elif defined(__linux__)
+	static const bool registered =
+		syscall(SYS_membarrier, MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0, 0) == 0;
+	return registered;
+#else
+	return false;
+#endif
+}
+
+/**
+* @brief The cheap side of an asymmetric fence, for the hot path (a writer publishing items).
+*
+* Only the compiler is kept from reordering when the other side can issue `asymmetricHeavyFence()`, which then acts as
+* a full fence on every thread of the process.
+*/
+inline void asymmetricLightFence() {
+	if (hasAsymmetricFences()) {
+		std::atomic_signal_fence(std::memory_order_seq_cst);
+	}
+	else {
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+	}
+}
+
+/**
+* @brief The expensive side of an asymmetric fence, for the slow path (a reader about to park).
+*/
+inline void asymmetricHeavyFence() {
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+#if defined(_WIN32)
+	FlushProcessWriteBuffers();
+#elif defined(__linux__)
+	if (hasAsymmetricFences()) {
+		syscall(SYS_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0, 0);
+	}
+#endif
+}
+
 /**
  * @brief `BUFFER_SEGMENT_ACCESS_LEVEL` enum defines the access level of an owner (instance of `BufferSegmentOwner`) on a
  * buffer segment (`BufferSegment`)
@@ -56,1121 +142,4422 @@ enum BUFFER_SEGMENT_ACCESS_LEVEL {
 };
 
 /**
-* @brief A class representing the owner of a buffer segment (`BufferSegment` instance)
+ * @brief `BUFFER_OVERFLOW_POLICY` enum defines what a dynamic buffer (`DynBuffer`) does when a new buffer segment would
+ * take its memory in use beyond its memory budget (`DynBuffer::setMemoryBudget()`).
+ *
+ * Here is what every constant defined in this enum means:
+ * BLOCK		- The writer waits until the readers have drained enough buffer segments.
+ * FAIL			- The write fails right away with a `BufferOverflowError`.
+ * DROP_OLDEST	- The oldest buffer segment which is not being read or written is dropped (its unread items are lost).
+ * DROP_NEWEST	- The items being written are dropped.
+ */
+enum BUFFER_OVERFLOW_POLICY {
+	BLOCK,							// WAIT FOR THE READERS
+	FAIL,							// THROW BufferOverflowError
+	DROP_OLDEST,					// DISCARD THE OLDEST ITEMS
+	DROP_NEWEST						// DISCARD THE INCOMING ITEMS
+};
+
+/**
+ * @brief `READER_LAG_POLICY` enum defines what happens to a reader attached to a writer's stream
+ * (`DynBuffer::attachReader()`) which falls behind the writer by more than its lag limit.
+ *
+ * Here is what every constant defined in this enum means:
+ * DETACH		- The reader is detached, its reads fail from then on. It no longer holds back the pruning.
+ * SKIP			- The reader no longer holds back the pruning, it skips the buffer segments pruned before it read them.
+ */
+enum READER_LAG_POLICY {
+	DETACH,							// STOP THE READER
+	SKIP							// LET THE READER LOSE THE OLDEST ITEMS
+};
+
+/**
+* @brief Thrown by the writes of a dynamic buffer whose memory budget is exhausted and whose overflow policy is
+* `BUFFER_OVERFLOW_POLICY::FAIL`, or when a single buffer segment would not fit in the budget at all.
+*/
+class BufferOverflowError : public std::runtime_error {
+public:
+	using std::runtime_error::runtime_error;
+};
+
+/**
+* @brief Bounds and tuning of the adaptive ("self-learning") sizing of new buffer segments.
 *
-* Note that the UID of the owner is decided only when it is used in a buffer. If the owner already has an ID then it means
-* that this owner is being used somewhere in some dynamic buffer and is not allowed to be used in any other
-* buffer.
+* The capacity of the next buffer segment of an owner is chosen from the owner's write rate and the lag of its reader,
+* both smoothed with an exponentially weighted moving average (EWMA) over the recent buffer segments:
+* - The size doubles while the writer fills a buffer segment in less than half of `targetFillMillis` or while the
+*   reader is behind by more than `lagThreshold` buffer segments (a sustained burst).
+* - The size halves when a buffer segment would take more than twice `targetFillMillis` to fill and the reader keeps
+*   up (light traffic).
+* The result is always a power of two between `minSize` and `maxSize`.
+*/
+struct SegmentSizingPolicy {
+	unsigned long long initialSize{ 1024 };		// The size of the first buffer segment of an owner
+	unsigned long long minSize{ 64 };			// The smallest size of a buffer segment
+	unsigned long long maxSize{ 1ULL << 20 };	// The largest size of a buffer segment
+	double targetFillMillis{ 10.0 };			// The time in which a buffer segment should be filled
+	double smoothing{ 0.25 };					// The weight of the latest buffer segment in the averages (0, 1]
+	double lagThreshold{ 4.0 };					// Reader lag (in buffer segments) treated as a burst
+};
+
+/**
+ * @brief `BUFFER_CONCURRENCY` enum defines how the streams of the owners of a dynamic buffer are shared among threads,
+ * fixed at compile time by the buffer's policy (`BufferPolicy`).
+ *
+ * Here is what every constant defined in this enum means:
+ * SPSC			- Every writer is used by a single thread and every stream is read by a single reader. The items are
+ *				  published by the writing thread itself (no writer worker) and no lock is taken to append them.
+ * MPSC			- A writer may be shared by several threads (its writes go through its writer worker), every stream is
+ *				  read by a single reader (no attached readers nor consumer groups).
+ * MPMC			- A writer may be shared by several threads and a stream may be read by several readers.
+ */
+enum BUFFER_CONCURRENCY {
+	SPSC,							// SINGLE PRODUCER, SINGLE CONSUMER
+	MPSC,							// MULTIPLE PRODUCERS, SINGLE CONSUMER
+	MPMC							// MULTIPLE PRODUCERS, MULTIPLE CONSUMERS
+};
+
+/**
+* @brief The compile-time policy of a dynamic buffer (`DynBuffer<T, Policy>`).
 *
-* The destruction of an instance of `BufferSegmentOwner` class is managed by `DynBuffer` class's destructor. The destructor
-* cannot be called explicitly.
+* @tparam Concurrency The sharing of the owners' streams among threads (see `BUFFER_CONCURRENCY`).
+* @tparam SegmentCapacity The capacity of every buffer segment, a power of two, or 0 for the adaptive sizing of
+* `SegmentSizingPolicy`. With a fixed capacity the bounds of a buffer segment are compile-time constants.
 */
-class BufferSegmentOwner {
+template <BUFFER_CONCURRENCY Concurrency = BUFFER_CONCURRENCY::MPMC, unsigned long long SegmentCapacity = 0>
+struct BufferPolicy {
+	static_assert(SegmentCapacity == 0 || std::has_single_bit(SegmentCapacity),
+		"The capacity of a buffer segment must be a power of two");
 
-public:
+	static constexpr BUFFER_CONCURRENCY concurrency = Concurrency;
+	static constexpr unsigned long long segmentCapacity = SegmentCapacity;
+};
 
-	// Delete copy constructor
-	BufferSegmentOwner(const BufferSegmentOwner&) = delete;
-	// Delete assignment operator
-	BufferSegmentOwner& operator=(const BufferSegmentOwner&) = delete;
+/**
+* @brief Stands in for `std::lock_guard` where the buffer's policy makes a lock unnecessary, so it is compiled out.
+*/
+struct ElidedLock {
+	explicit ElidedLock(std::mutex&) {}
+};
 
-	template <typename T> friend class DynBuffer;
-	template <typename T> friend class BufferSegment;
+/**
+* @brief Type independent interface of the long-lived writer worker attached to a `BufferSegmentOwner`.
+*
+* `BufferSegmentOwner` is not a template, so it only holds the worker through this interface. The typed worker
+* (`SegmentWriterWorker<T>`) is created by the `DynBuffer<T>` the owner is used in.
+*/
+class OwnerWorker {
+public:
+
+	virtual ~OwnerWorker() = default;
 
 	/**
-	* @brief Constructor to create an anonymous owner with provided access level on the buffer segment.
-	*
-	* @param accessLevel The access level with which the buffer segment will be used.
+	* @brief Blocks until every item submitted so far has been written to the buffer.
 	*/
-	BufferSegmentOwner(enum BUFFER_SEGMENT_ACCESS_LEVEL accessLevel) : bufferSegmentAccessLevel(accessLevel) {}
+	virtual void flush() = 0;
 
 	/**
-	* @brief Constructor to create an owner with the given name with provided access level on the buffer segment.
-	*
-	* @param name The name of the owner.
-	* @param accessLevel The access level with which the buffer segment will be used.
+	* @brief Drains the remaining submissions and joins the worker thread. Safe to call more than once.
 	*/
-	BufferSegmentOwner(
-		std::string name, BUFFER_SEGMENT_ACCESS_LEVEL accessLevel
-	) : name(name), bufferSegmentAccessLevel(accessLevel) {}
+	virtual void stop() = 0;
+};
 
-	static std::pair<BufferSegmentOwner*, BufferSegmentOwner*> getReaderWriterPair(std::string readerName, std::string writerName) {
-		BufferSegmentOwner* reader = new BufferSegmentOwner(readerName, BUFFER_SEGMENT_ACCESS_LEVEL::READ);
-		BufferSegmentOwner* writer = new BufferSegmentOwner(writerName, BUFFER_SEGMENT_ACCESS_LEVEL::WRITE);
+/**
+* @brief A persistent writer worker fed by a bounded submission queue.
+*
+* `submit()` only copies the item into a ring buffer and, if the worker is parked, wakes it up. The worker thread moves
+* everything queued at that moment into a local batch and hands the batch to the `sink` (the owning `DynBuffer`) outside
+* of the queue lock, so producers are never blocked by segment writes unless the queue is full.
+*
+* Exceptions thrown by the sink are kept and re-thrown to the producer on the next `submit()` or `flush()`.
+*/
+template <typename T> class SegmentWriterWorker : public OwnerWorker {
+public:
 
-		reader->isPartOfReaderWriterPair = true;
-		writer->isPartOfReaderWriterPair = true;
+	using Sink = std::function<void(T*, unsigned long long)>;	// May move the items out of the batch
 
-		reader->partner = writer;
-		writer->partner = reader;
+	// Delete copy constructor
+	SegmentWriterWorker(const SegmentWriterWorker&) = delete;
+	// Delete assignment operator
+	SegmentWriterWorker& operator=(const SegmentWriterWorker&) = delete;
 
-		return std::pair<BufferSegmentOwner*, BufferSegmentOwner*>(reader, writer);
+	/**
+	* @brief Constructor to start a worker with a submission queue of `capacity` items.
+	*
+	* @param capacity The maximum number of items waiting in the queue before `submit()` blocks.
+	* @param sink The function which writes a batch of items into the buffer segments.
+	*/
+	SegmentWriterWorker(unsigned long long capacity, Sink sink) :
+		queue(static_cast<T*>(::operator new(capacity * sizeof(T), std::align_val_t(alignof(T))))),
+		capacity(capacity), sink(std::move(sink)), worker([this]() { run(); }) {}
+
+	/**
+	* @brief Destructor
+	*/
+	~SegmentWriterWorker() override {
+		stop();
+		::operator delete(static_cast<void*>(queue), std::align_val_t(alignof(T)));
 	}
 
 	/**
-	* @brief Accessor function to get the ID of this owner
+	* @brief Enqueues a single item for writing. Blocks only while the submission queue is full.
+	*
+	* @param item The item to be written.
 	*/
-	ull getID() const {
-		return UID;
+	void submit(const T& item) {
+		emplace(item);
 	}
 
 	/**
-	* @brief Accessor function to get the access level of the owner on the buffer segment(s) it owns.
+	* @brief Enqueues a single item for writing by moving it into the submission queue.
 	*/
-	BUFFER_SEGMENT_ACCESS_LEVEL getAccessLevel() const {
-		return bufferSegmentAccessLevel;
+	void submit(T&& item) {
+		emplace(std::move(item));
 	}
 
-private:
+	/**
+	* @brief Enqueues an item constructed from `args`. Blocks only while the submission queue is full.
+	*/
+	template <typename... Args> void emplace(Args&&... args) {
+		std::unique_lock<std::mutex> lock(queueMutex);
+		rethrowPending();
+		if (stopping) {
+			throw std::runtime_error("ERR: WRITER WORKER STOPPED");
+		}
+		notFull.wait(lock, [this]() { return count < capacity; });
+		std::construct_at(queue + (head + count) % capacity, std::forward<Args>(args)...);
+		++count;
+		++submitted;
+		bool wake = workerParked;
+		lock.unlock();
+		if (wake) {
+			notEmpty.notify_one();
+		}
+	}
 
-	std::string name{};						// The name of the owner (default : empty indicating no name)
-	ull UID{ INVALID_ID };					// The unique ID of the owner (initially 0). Every UID that has the
-	// value 0 means that the UID has not been set.
-	std::thread* ownerThread{ nullptr };		// Owner's thread (uninitialized), initialize using `new` keyword
-	std::mutex* ownerThreadMutex{ new std::mutex };            // Used to lock on to owner thread before changing it
+	void flush() override {
+		std::unique_lock<std::mutex> lock(queueMutex);
+		drainedCV.wait(lock, [this]() { return drained == submitted; });
+		rethrowPending();
+	}
 
-	BUFFER_SEGMENT_ACCESS_LEVEL bufferSegmentAccessLevel{ BUFFER_SEGMENT_ACCESS_LEVEL::INVALID };
+	void stop() override {
+		{
+			std::lock_guard<std::mutex> lock(queueMutex);
+			stopping = true;
+		}
+		notEmpty.notify_one();
+		if (worker.joinable()) {
+			worker.join();
+		}
+	}
 
-	int refCount{ 0 };							// The number of references to this particular instance (default 0).
-	// When this instance of `BufferSegmentOwner` is used anywhere, the
-	// refCount has to be incremented and when erased from a
-	// `BufferSegment`'s owner's list, `refCount` has to be decremented.
+private:
 
-	BufferSegmentOwner* partner{ nullptr };
-	bool isPartOfReaderWriterPair{ false };
+	T* queue{ nullptr };							// Ring buffer of submitted items, a slot holds an item only while queued
+	unsigned long long capacity{ 0 };				// Number of slots in `queue`
+	unsigned long long head{ 0 };					// Index of the oldest submitted item in `queue`
+	unsigned long long count{ 0 };					// Number of items waiting in `queue`
+	unsigned long long submitted{ 0 };				// Total number of items ever submitted
+	unsigned long long drained{ 0 };				// Total number of items handed to the sink
+	bool workerParked{ false };						// Whether the worker is waiting for new submissions
+	bool stopping{ false };							// Set once the worker is asked to finish
+	std::exception_ptr pendingError{ nullptr };		// The last error raised by the sink
 
-	/*
-	* The index at which this buffer segment owner is reading the buffer. Note that writing index is not present in
-	* this buffer segment for the very reason that multiple arbitrary reads are allowed on a buffer segment while
-	* only one owner is allowed to perform a complete non-arbitrary write to the entire buffer segment. The entire
-	* buffer segment might not be used totally so the lock for write will be removed and until the partner owner
-	* (if present) reads the entire buffer segment already written to or reads it arbitrarly till complete read, the
-	* permission for write will not be given until the entire buffer segment has been read. This buffer segment
-	* reading index is reset as soon as last element is read by this owner.
-	*/
-	std::atomic<unsigned long long> bufferSegmentItemsArrayReadIndex{ 0ULL };
+	std::mutex queueMutex;
+	std::condition_variable notEmpty;
+	std::condition_variable notFull;
+	std::condition_variable drainedCV;
 
-	/*
-	* The index of the buffer segment being read. The owner advances linearly to the right of the
-	* std::vector<BufferSegment<T>*> as reading is done.
-	*
-	* TODO: Use std::vector instead of a list in storing buffer segments. This will allow to use a specific buffer
-	* segment and will be good for pruner threads as well.
-	*/
-	std::atomic<unsigned long long> bufferSegmentReadIndex{ 0ULL };
+	Sink sink;
+	std::thread worker;								// Must be the last member, it starts running in the constructor
 
 	/**
-	* @brief Destructor
+	* @brief Re-throws (once) the error raised by the sink. Must be called with `queueMutex` held.
 	*/
-	~BufferSegmentOwner() {
-		if (ownerThread != nullptr) {
-			// Wait for owner's thread to finish its task before deleting it
-			if (ownerThread->joinable()) {
-				ownerThread->join();
-			}
-			delete ownerThread; // Delete the ownerThread object
-			ownerThread = nullptr;
+	void rethrowPending() {
+		if (pendingError != nullptr) {
+			std::exception_ptr error = pendingError;
+			pendingError = nullptr;
+			std::rethrow_exception(error);
 		}
-		// delete the mutex
-		delete ownerThreadMutex;
-		ownerThreadMutex = nullptr;
 	}
 
 	/**
-	* @brief Assigns unique ID to this owner
-	*
-	* @param dynamicBuffer Pointer to an instance of `DynBuffer` class which calls this method.
-	*
-	* NOTE: This function is meant to be called by an instance of `DynBuffer` class only.
-	* The function looks for IDs of owners already present in the various segment buffers and generates a unique ID
-	* for this owner.
-	*
+	* @brief The worker loop. Takes every queued item in one go and writes them as a single batch.
 	*/
-	void assignUID() {
-		static ull uniqueId {0};
-		try {
-			if(uniqueId != ULLONG_MAX)
-				UID = ++uniqueId;
-			else {
-				throw std::runtime_error("Number of unique IDs exhausted.");
+	void run() {
+		std::vector<T> batch;
+		batch.reserve(capacity);
+		std::unique_lock<std::mutex> lock(queueMutex);
+		while (true) {
+			workerParked = true;
+			notEmpty.wait(lock, [this]() { return count > 0 || stopping; });
+			workerParked = false;
+			if (count == 0) {
+				break;	// stopping and nothing left to drain
+			}
+			// Move the queued items out of the ring buffer
+			unsigned long long taken = count;
+			for (unsigned long long i = 0; i < taken; ++i) {
+				T* slot = queue + (head + i) % capacity;
+				batch.push_back(std::move(*slot));
+				std::destroy_at(slot);
+			}
+			head = (head + taken) % capacity;
+			count = 0;
+			lock.unlock();
+			notFull.notify_all();
+
+			try {
+				sink(batch.data(), batch.size());
+			}
+			catch (...) {
+				lock.lock();
+				pendingError = std::current_exception();
+				lock.unlock();
 			}
+			batch.clear();
+
+			lock.lock();
+			drained += taken;
+			drainedCV.notify_all();
 		}
-		catch (const std::exception& e) {
-			// UID Generation failed
-			UID = INVALID_ID;
-			std::cout << e.what() << std::endl; // or log
+	}
+};
+
+/**
+* @brief The epoch-based reclamation domain shared by all the dynamic buffers of the process.
+*
+* A thread enters a critical section (`EpochGuard`) before it dereferences a buffer segment (or a chunk of a segment
+* directory) found through the shared structures of a dynamic buffer, and leaves it when it is done. Entering only
+* publishes the current global epoch in the thread's own record, so readers never take a lock and never wait.
+*
+* Memory removed from the shared structures is retired (`EpochLimbo::retire()`) with the global epoch of that moment.
+* The global epoch advances only when every thread inside a critical section has observed it, so once it has advanced
+* twice since the retirement no thread can still hold a reference and the memory is freed.
+*
+* The records of the threads are kept in chunks of `RECORDS_PER_CHUNK`, a new chunk is linked when every record is
+* claimed by a live thread. The chunks are never freed, the records of the threads which exited are reused.
+*/
+class EpochDomain {
+public:
+
+	static constexpr unsigned long long RECORDS_PER_CHUNK = 256;	// The number of thread records in a chunk
+	static constexpr unsigned long long QUIESCENT = 0;			// The epoch of a thread outside a critical section
+
+	// Delete copy constructor
+	EpochDomain(const EpochDomain&) = delete;
+	// Delete assignment operator
+	EpochDomain& operator=(const EpochDomain&) = delete;
+
+	/**
+	* @brief Get the domain of the process.
+	*/
+	static EpochDomain& instance() {
+		static EpochDomain domain;
+		return domain;
+	}
+
+	/**
+	* @brief Enters a critical section of the calling thread. Critical sections can be nested.
+	*/
+	void enter() {
+		ThreadRecord* record = recordOfThisThread();
+		if ((record->nesting)++ == 0) {
+			record->epoch.store(globalEpoch.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			// Publish the epoch before any buffer segment is loaded
+			std::atomic_thread_fence(std::memory_order_seq_cst);
 		}
 	}
 
 	/**
-	* @brief Checks if this owner has an ID
-	*
-	* @return true if this owner has an ID, false otherwise
+	* @brief Leaves the critical section entered by `enter()`.
 	*/
-	bool hasUID() const {
-		return UID != INVALID_ID;
+	void exit() {
+		ThreadRecord* record = recordOfThisThread();
+		if (--(record->nesting) == 0) {
+			record->epoch.store(QUIESCENT, std::memory_order_release);
+		}
 	}
 
 	/**
-	* @brief Get a pointer-to-pointer to this owner's thread.
+	* @brief Get the global epoch.
 	*/
-	std::thread** getPPThread() {
-		return &ownerThread;
+	unsigned long long currentEpoch() const {
+		return globalEpoch.load(std::memory_order_acquire);
 	}
 
 	/**
-	* @brief Get the reference count.
+	* @brief Advances the global epoch if every thread inside a critical section has observed it.
 	*
-	* Number of references to this instance.
+	* @return The global epoch after the attempt.
 	*/
-	int getRefCount() const {
-		return refCount;
+	unsigned long long tryAdvance() {
+		unsigned long long epoch = globalEpoch.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		for (RecordChunk* chunk = &firstChunk; chunk != nullptr; chunk = chunk->next.load(std::memory_order_acquire)) {
+			for (unsigned long long i = 0; i < RECORDS_PER_CHUNK; ++i) {
+				unsigned long long observed = chunk->records[i].epoch.load(std::memory_order_acquire);
+				if (observed != QUIESCENT && observed != epoch) {
+					return epoch;
+				}
+			}
+		}
+		globalEpoch.compare_exchange_strong(epoch, epoch + 1, std::memory_order_acq_rel);
+		return globalEpoch.load(std::memory_order_acquire);
 	}
 
+private:
+
 	/**
-	* @brief Increments count of references
+	* @brief The epoch record of a thread, on a cache line of its own.
 	*/
-	void incrementRefCount() {
-		++refCount;
-	}
+	struct alignas(CACHE_LINE_SIZE) ThreadRecord {
+		std::atomic<unsigned long long> epoch{ QUIESCENT };	// The epoch observed when the critical section was entered
+		std::atomic<bool> claimed{ false };					// Whether a thread holds this record
+		unsigned long long nesting{ 0 };					// The depth of the critical sections of the thread
+	};
 
 	/**
-	* @brief Increments count of references
+	* @brief Gives the record back when its thread exits.
 	*/
-	void decrementRefCount() {
-		++refCount;
+	struct ThreadHandle {
+		ThreadRecord* record{ nullptr };
+
+		~ThreadHandle() {
+			if (record != nullptr) {
+				record->epoch.store(QUIESCENT, std::memory_order_release);
+				record->nesting = 0;
+				record->claimed.store(false, std::memory_order_release);
+			}
+		}
+	};
+
+	/**
+	* @brief A chunk of thread records, linked to the next one once it is full.
+	*/
+	struct RecordChunk {
+		ThreadRecord records[RECORDS_PER_CHUNK]{};			// The records of the threads
+		std::atomic<RecordChunk*> next{ nullptr };			// The next chunk, set once
+	};
+
+	RecordChunk firstChunk;										// The first records, the others are linked to it
+	std::atomic<unsigned long long> globalEpoch{ 1 };			// The global epoch
+
+	EpochDomain() = default;
+
+	/**
+	* @brief Get the record of the calling thread, claiming a free one on the first call.
+	*/
+	ThreadRecord* recordOfThisThread() {
+		thread_local ThreadHandle handle;
+		RecordChunk* chunk = &firstChunk;
+		while (handle.record == nullptr) {
+			for (unsigned long long i = 0; i < RECORDS_PER_CHUNK; ++i) {
+				bool expected{ false };
+				if (chunk->records[i].claimed.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+					handle.record = &(chunk->records[i]);
+					break;
+				}
+			}
+			if (handle.record != nullptr) {
+				break;
+			}
+			RecordChunk* next = chunk->next.load(std::memory_order_acquire);
+			if (next == nullptr) {
+				// Every record is claimed, link a new chunk. A thread losing the race scans the winner's chunk
+				RecordChunk* grown = new RecordChunk();
+				if (chunk->next.compare_exchange_strong(next, grown, std::memory_order_acq_rel, std::memory_order_acquire)) {
+					next = grown;
+				}
+				else {
+					delete grown;
+				}
+			}
+			chunk = next;
+		}
+		return handle.record;
 	}
 };
 
 /**
-* @brief A buffer segment
-*
-* Creation of buffer segment is in the hands of `DynBuffer` instance.
-* A buffer segment allows multiple reads but a single complete write at a time.
-*
-* A buffer segment can have multiple readers so even if the reader associated with the writer have already read the written
-* contents, the reader will not remove itself from the list of owners of that buffer segment. It is the work of pruner
-* threads to delete buffer segments which in turn clears the owners as well.
+* @brief Keeps the calling thread inside an epoch critical section (`EpochDomain`) for its scope.
 */
-template <typename T> class BufferSegment {
+class EpochGuard {
 public:
 
-	template <typename D> friend class DynBuffer;
-
 	// Delete copy constructor
-	BufferSegment(const BufferSegment&) = delete;
+	EpochGuard(const EpochGuard&) = delete;
 	// Delete assignment operator
-	BufferSegment& operator=(const BufferSegment&) = delete;
+	EpochGuard& operator=(const EpochGuard&) = delete;
 
-	// Delete default constructor
-	BufferSegment() = delete;
+	EpochGuard() {
+		EpochDomain::instance().enter();
+	}
 
-private:
+	~EpochGuard() {
+		EpochDomain::instance().exit();
+	}
+};
 
-	std::atomic<T*> items{ nullptr };								// This array houses items within a buffer segment. This array can be used
-	// in reading a large file which reads in chunk. Reading in large chunks
-	// would be fast as the Dynamic Buffer (DynBuffer) that houses Buffer
-	// Segments (BufferSegment instances) will grow/shrink dynamically as per
-	// the read speed with a maximum overall memory limit of some X MB.
-	unsigned long long size{ 0 };										// The size of the `items` array.
-	std::atomic<unsigned long long> writingIndex{ 0 };				// The index before which other owners have access to perform read
-	// operations. Also it is the index that is used to write to the `items`
-	// array.
+/**
+* @brief The memory retired by a dynamic buffer and not freed yet (see `EpochDomain`).
+*
+* Retiring and collecting happen on the slow paths only (pruning, the memory budget), so the list is kept under a mutex.
+*/
+class EpochLimbo {
+public:
 
-	std::list<BufferSegmentOwner*>*
-		owners{ nullptr };								// A set of owners of this buffer segment
-	BufferSegmentOwner* currentOwner{ nullptr };		// The current owner of this buffer segment
+	using Reclaim = std::function<void()>;
+
+	// Delete copy constructor
+	EpochLimbo(const EpochLimbo&) = delete;
+	// Delete assignment operator
+	EpochLimbo& operator=(const EpochLimbo&) = delete;
+
+	EpochLimbo() = default;
+
+	/**
+	* @brief Destructor
+	*
+	* Frees everything still retired, no thread can be reading the dynamic buffer anymore.
+	*/
+	~EpochLimbo() {
+		reclaimAll();
+	}
+
+	/**
+	* @brief Retires memory which is no longer reachable through the shared structures of the dynamic buffer.
+	*
+	* @param reclaim Frees the memory once no thread can hold a reference to it.
+	*/
+	void retire(Reclaim reclaim) {
+		std::lock_guard<std::mutex> lock(mutex);
+		retired.push_back({ EpochDomain::instance().currentEpoch(), std::move(reclaim) });
+		retiredCount.store(retired.size(), std::memory_order_release);
+	}
+
+	/**
+	* @brief Check if nothing is waiting to be freed, without taking the lock.
+	*/
+	bool isEmpty() const {
+		return retiredCount.load(std::memory_order_acquire) == 0;
+	}
+
+	/**
+	* @brief Tries to advance the global epoch and frees the memory retired at least two epochs ago.
+	*
+	* @return The number of retired entries freed.
+	*/
+	unsigned long long collect() {
+		EpochDomain& domain = EpochDomain::instance();
+		domain.tryAdvance();
+		unsigned long long epoch = domain.tryAdvance();
+		// Reused across the calls of a thread, buffer segments are recycled through here
+		thread_local std::vector<Reclaim> ready;
+		ready.clear();
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			auto isReady = [epoch](const Entry& entry) { return entry.epoch + 2 <= epoch; };
+			for (Entry& entry : retired) {
+				if (isReady(entry)) {
+					ready.push_back(std::move(entry.reclaim));
+				}
+			}
+			std::erase_if(retired, isReady);
+			retiredCount.store(retired.size(), std::memory_order_release);
+		}
+		// Free outside of the lock, reclaiming may retire more
+		for (Reclaim& reclaim : ready) {
+			reclaim();
+		}
+		unsigned long long reclaimed = ready.size();
+		ready.clear();
+		return reclaimed;
+	}
+
+	/**
+	* @brief Frees everything retired regardless of the epochs. Only for the destruction of the dynamic buffer.
+	*/
+	void reclaimAll() {
+		std::vector<Entry> all;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			all.swap(retired);
+			retiredCount.store(0, std::memory_order_release);
+		}
+		for (Entry& entry : all) {
+			entry.reclaim();
+		}
+	}
+
+private:
+
+	struct Entry {
+		unsigned long long epoch;		// The global epoch when the memory was retired
+		Reclaim reclaim;				// Frees the memory
+	};
+
+	std::mutex mutex;					// A mutex for using lock on `retired`
+	std::vector<Entry> retired;			// The retired memory in the order of retirement
+	std::atomic<unsigned long long> retiredCount{ 0 };	// The size of `retired`, read without the lock
+};
+
+/**
+* @brief A 32-bit event counter threads can park on until it is bumped (a futex word on Linux, `WaitOnAddress` on
+* Windows, `std::atomic::wait` elsewhere).
+*
+* `std::atomic::wait` has no timed variant, hence the platform calls. The waiter loads the counter, re-checks its
+* condition and then waits for the counter to differ from what it loaded, so a bump in between is never missed.
+*/
+class ParkingWord {
+public:
+
+	/**
+	* @brief Get the current value of the counter, to be passed to `wait()`.
+	*/
+	std::uint32_t load() const {
+		return word.load(std::memory_order_acquire);
+	}
+
+	/**
+	* @brief Parks the calling thread until the counter differs from `expected` or the `deadline` has passed.
+	*
+	* May return early (spuriously), the caller re-checks its condition.
+	*
+	* @return false if the deadline has passed.
+	*/
+	bool wait(std::uint32_t expected, const std::optional<std::chrono::steady_clock::time_point>& deadline) {
+		while (word.load(std::memory_order_acquire) == expected) {
+			std::chrono::nanoseconds remaining{ 0 };
+			if (deadline.has_value()) {
+				remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(
+					*deadline - std::chrono::steady_clock::now()
+				);
+				if (remaining.count() <= 0) {
+					return false;
+				}
+			}
+#if defined(_WIN32)
+			DWORD milliseconds = deadline.has_value()
+				? (DWORD)(std::chrono::ceil<std::chrono::milliseconds>(remaining).count())
+				: INFINITE;
+			WaitOnAddress(&word, &expected, sizeof(expected), milliseconds);
+#elif defined(__linux__)
+			timespec timeout{};
+			timeout.tv_sec = (time_t)(remaining.count() / 1000000000LL);
+			timeout.tv_nsec = (long)(remaining.count() % 1000000000LL);
+			syscall(
+				SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAIT_PRIVATE, expected,
+				deadline.has_value() ? &timeout : nullptr, nullptr, 0
+			);
+#else
+			if (deadline.has_value()) {
+				std::this_thread::sleep_for(std::min<std::chrono::nanoseconds>(remaining, std::chrono::milliseconds(1)));
+			}
+			else {
+				word.wait(expected, std::memory_order_acquire);
+			}
+#endif
+		}
+		return true;
+	}
+
+	/**
+	* @brief Bumps the counter and wakes every parked thread.
+	*/
+	void wakeAll() {
+		word.fetch_add(1, std::memory_order_acq_rel);
+#if defined(_WIN32)
+		WakeByAddressAll(&word);
+#elif defined(__linux__)
+		syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#else
+		word.notify_all();
+#endif
+	}
+
+private:
+
+	std::atomic<std::uint32_t> word{ 0 };		// The event counter
+};
+
+/**
+* @brief Type independent interface of the index of the buffer segments owned by a `BufferSegmentOwner` in a dynamic
+* buffer (`OwnedSegmentIndex<T>`).
+*/
+class OwnerSegmentIndex {
+public:
+
+	virtual ~OwnerSegmentIndex() = default;
+};
+
+/**
+* @brief A class representing the owner of a buffer segment (`BufferSegment` instance)
+*
+* Note that the UID of the owner is decided only when it is used in a buffer. If the owner already has an ID then it means
+* that this owner is being used somewhere in some dynamic buffer and is not allowed to be used in any other
+* buffer.
+*
+* The destruction of an instance of `BufferSegmentOwner` class is managed by `DynBuffer` class's destructor. The destructor
+* cannot be called explicitly.
+*/
+class BufferSegmentOwner {
+
+public:
+
+	// Delete copy constructor
+	BufferSegmentOwner(const BufferSegmentOwner&) = delete;
+	// Delete assignment operator
+	BufferSegmentOwner& operator=(const BufferSegmentOwner&) = delete;
+
+	template <typename T, typename Policy> friend class DynBuffer;
+	template <typename T> friend class BufferSegment;
+
+	/**
+	* @brief Constructor to create an anonymous owner with provided access level on the buffer segment.
+	*
+	* @param accessLevel The access level with which the buffer segment will be used.
+	*/
+	BufferSegmentOwner(enum BUFFER_SEGMENT_ACCESS_LEVEL accessLevel) : bufferSegmentAccessLevel(accessLevel) {}
+
+	/**
+	* @brief Constructor to create an owner with the given name with provided access level on the buffer segment.
+	*
+	* @param name The name of the owner.
+	* @param accessLevel The access level with which the buffer segment will be used.
+	*/
+	BufferSegmentOwner(
+		std::string name, BUFFER_SEGMENT_ACCESS_LEVEL accessLevel
+	) : name(name), bufferSegmentAccessLevel(accessLevel) {}
+
+	static std::pair<BufferSegmentOwner*, BufferSegmentOwner*> getReaderWriterPair(std::string readerName, std::string writerName) {
+		BufferSegmentOwner* reader = new BufferSegmentOwner(readerName, BUFFER_SEGMENT_ACCESS_LEVEL::READ);
+		BufferSegmentOwner* writer = new BufferSegmentOwner(writerName, BUFFER_SEGMENT_ACCESS_LEVEL::WRITE);
+
+		reader->isPartOfReaderWriterPair = true;
+		writer->isPartOfReaderWriterPair = true;
+
+		reader->partner = writer;
+		writer->partner = reader;
+
+		return std::pair<BufferSegmentOwner*, BufferSegmentOwner*>(reader, writer);
+	}
+
+	/**
+	* @brief Accessor function to get the ID of this owner
+	*/
+	ull getID() const {
+		return UID;
+	}
+
+	/**
+	* @brief Accessor function to get the access level of the owner on the buffer segment(s) it owns.
+	*/
+	BUFFER_SEGMENT_ACCESS_LEVEL getAccessLevel() const {
+		return bufferSegmentAccessLevel;
+	}
+
+private:
+
+	std::string name{};						// The name of the owner (default : empty indicating no name)
+	ull UID{ INVALID_ID };					// The unique ID of the owner (initially 0). Every UID that has the
+	// value 0 means that the UID has not been set.
+	std::atomic<OwnerWorker*> writerWorker{ nullptr };	// Owner's long-lived writer worker (created by the
+	// `DynBuffer` on the first write of this owner)
+	std::mutex writerWorkerMutex;					// Used to lock on to the writer worker while creating it
+	std::mutex appendMutex;							// Keeps the appends of this owner to its buffer segments in order
+	std::atomic<OwnerSegmentIndex*> segmentIndex{ nullptr };	// Index of the buffer segments owned by this owner
+	// (created and freed by the `DynBuffer` the owner is used in)
+	unsigned long long reservedItems{ 0 };			// The number of items reserved by `DynBuffer::reserve()` and not
+	// committed yet (guarded by `appendMutex`)
+	unsigned long long readViewItems{ 0 };			// The number of items in the view returned by
+	// `DynBuffer::acquireRead()` and not released yet
+	void* readViewSegment{ nullptr };				// The buffer segment pinned by that view
+	std::vector<std::pair<void*, unsigned long long>> readViews;	// The buffer segments (and the number of items)
+	// of the views returned by `DynBuffer::acquireReadv()` and not released yet
+	unsigned long long readSpins{ 256 };			// The number of times a blocking read polls before it parks,
+	// adapted to how long the owner usually waits for new items
+
+	BUFFER_SEGMENT_ACCESS_LEVEL bufferSegmentAccessLevel{ BUFFER_SEGMENT_ACCESS_LEVEL::INVALID };
+
+	std::atomic<int> refCount{ 0 };			// The number of references to this particular instance (default 0).
+	// When this instance of `BufferSegmentOwner` is used anywhere, the
+	// refCount has to be incremented and when erased from a
+	// `BufferSegment`'s owner's list, `refCount` has to be decremented.
+
+	BufferSegmentOwner* partner{ nullptr };
+	bool isPartOfReaderWriterPair{ false };
 
-	std::mutex* writerMutex{ new std::mutex };								// A mutex for using lock on write operations
-	std::mutex* readerMutex{ new std::mutex };								// A mutex for using lock on read operations
+	// Reader attached to the stream of a writer (see `DynBuffer::attachReader()`)
+	BufferSegmentOwner* broadcastWriter{ nullptr };	// The writer whose buffer segments this reader reads
+	unsigned long long maxLagSegments{ 0 };			// The number of buffer segments the reader may fall behind the
+	// writer by before `lagPolicy` applies (0 : unlimited)
+	READER_LAG_POLICY lagPolicy{ READER_LAG_POLICY::DETACH };
+	std::atomic<bool> detached{ false };			// Whether the reader was detached for falling behind
+	std::atomic<unsigned long long> skippedSegments{ 0 };	// The buffer segments pruned before this owner read them
+
+	// Consumer group sharing the stream of a writer among its workers (see `DynBuffer::createConsumerGroup()`)
+	bool isConsumerGroup{ false };					// Whether this attached reader is a consumer group
+	std::atomic<unsigned long long> claimCursor{ 0 };	// The next item handed out to a worker (buffer segment index
+	// in the high 32 bits, item index in the low 32 bits)
+	unsigned long long sliceItems{ 0 };				// The most items handed out by one claim (0 : up to everything
+	// published in the buffer segment)
+	unsigned long long groupWorkers{ 0 };			// The workers joined to the group
+	BufferSegmentOwner* consumerGroup{ nullptr };	// The group a worker claims its items from
 
 	/*
-	* Note that there is no special bool variable for those owners who have both read and write access. Instead, the
-	* following two variables -- `inWrite` and `inRead` are used.
+	* The index at which this buffer segment owner is reading the buffer. Note that writing index is not present in
+	* this buffer segment for the very reason that multiple arbitrary reads are allowed on a buffer segment while
+	* only one owner is allowed to perform a complete non-arbitrary write to the entire buffer segment. The entire
+	* buffer segment might not be used totally so the lock for write will be removed and until the partner owner
+	* (if present) reads the entire buffer segment already written to or reads it arbitrarly till complete read, the
+	* permission for write will not be given until the entire buffer segment has been read. This buffer segment
+	* reading index is reset as soon as last element is read by this owner.
+	*/
+	std::atomic<unsigned long long> bufferSegmentItemsArrayReadIndex{ 0ULL };
+
+	/*
+	* The logical index of the buffer segment being read, among the buffer segments of the owner being read (its own or
+	* the writer's it is attached to). It counts the recycled ones too, so it stays valid as the oldest buffer segments
+	* are recycled: the buffer segment is `segments[bufferSegmentReadIndex - recycled]` of that owner's
+	* `OwnedSegmentIndex`. The owner advances it by one as each buffer segment is read completely.
 	*/
+	std::atomic<unsigned long long> bufferSegmentReadIndex{ 0ULL };
+
 	/**
-	* A flag variable that marks whether this buffer segment is in use and is being written to. If a thread has a
-	* lock on this buffer segment and is writing to the buffer, other threads will not be allowed to write to the same.
+	* @brief Destructor
 	*/
-	std::atomic<bool> inWrite{ false };
+	~BufferSegmentOwner() {
+		OwnerWorker* pWorker = writerWorker.exchange(nullptr);
+		if (pWorker != nullptr) {
+			// Let the worker finish writing its queued items before deleting it
+			pWorker->stop();
+			delete pWorker;
+		}
+	}
 
 	/**
-	* A flag variable that marks whether this buffer segment is in use and is being read. The thread simply gets an
-	* access to the buffer segment without acquiring a lock on the critical section / resource. If data is being
-	* written by another thread then until that thread relinquishes its control, reading is not allowed.
+	* @brief Assigns unique ID to this owner
+	*
+	* @param dynamicBuffer Pointer to an instance of `DynBuffer` class which calls this method.
+	*
+	* NOTE: This function is meant to be called by an instance of `DynBuffer` class only.
+	* The function looks for IDs of owners already present in the various segment buffers and generates a unique ID
+	* for this owner.
+	*
+	*/
+	void assignUID() {
+		static ull uniqueId {0};
+		try {
+			if(uniqueId != ULLONG_MAX)
+				UID = ++uniqueId;
+			else {
+				throw std::runtime_error("Number of unique IDs exhausted.");
+			}
+		}
+		catch (const std::exception& e) {
+			// UID Generation failed
+			UID = INVALID_ID;
+			std::cout << e.what() << std::endl; // or log
+		}
+	}
+
+	/**
+	* @brief Checks if this owner has an ID
+	*
+	* @return true if this owner has an ID, false otherwise
+	*/
+	bool hasUID() const {
+		return UID != INVALID_ID;
+	}
+
+	/**
+	* @brief Waits for the owner's writer worker (if any) to finish writing every submitted item.
+	*/
+	void flushWriterWorker() {
+		OwnerWorker* pWorker = writerWorker.load(std::memory_order_acquire);
+		if (pWorker != nullptr) {
+			pWorker->flush();
+		}
+	}
+
+	/**
+	* @brief Get the reference count.
+	*
+	* Number of references to this instance.
+	*/
+	int getRefCount() const {
+		return refCount;
+	}
+
+	/**
+	* @brief Increments count of references
+	*/
+	void incrementRefCount() {
+		++refCount;
+	}
+
+	/**
+	* @brief Decrements count of references
+	*/
+	void decrementRefCount() {
+		--refCount;
+	}
+};
+
+/**
+* @brief A buffer segment
+*
+* Creation of buffer segment is in the hands of `DynBuffer` instance.
+* A buffer segment allows multiple reads but a single complete write at a time.
+*
+* A buffer segment can have multiple readers so even if the reader associated with the writer have already read the written
+* contents, the reader will not remove itself from the list of owners of that buffer segment. It is the work of pruner
+* threads to delete buffer segments which in turn clears the owners as well.
+*/
+template <typename T> class BufferSegment {
+public:
+
+	template <typename D, typename Policy> friend class DynBuffer;
+	template <typename D> friend class SegmentPool;
+
+	// Delete copy constructor
+	BufferSegment(const BufferSegment&) = delete;
+	// Delete assignment operator
+	BufferSegment& operator=(const BufferSegment&) = delete;
+
+	// Delete default constructor
+	BufferSegment() = delete;
+
+	/**
+	* @brief Get the `items` array, filled by the caller of `DynBuffer::reserveSegment()` before the buffer segment is
+	* appended by `DynBuffer::commitSegment()`.
+	*/
+	T* getItems() const {
+		return items;
+	}
+
+	/**
+	* @brief Get the number of items the `items` array can hold.
+	*/
+	unsigned long long getSize() const {
+		return size;
+	}
+
+private:
+
+	/*
+	* The header of a buffer segment is laid out in cache lines by who writes them: the metadata set when the buffer
+	* segment is handed out (read-mostly afterwards), the state written by the writer and the state written by the
+	* readers. A writer publishing items and its readers pinning the buffer segment do not invalidate each other's
+	* lines. The header and the `items` array are a single allocation (see `create()`).
+	*/
+
+	// Metadata, written when the buffer segment is handed out
+
+	T* items{ nullptr };											// This array houses items within a buffer segment. This array can be used
+	// in reading a large file which reads in chunk. Reading in large chunks
+	// would be fast as the Dynamic Buffer (DynBuffer) that houses Buffer
+	// Segments (BufferSegment instances) will grow/shrink dynamically as per
+	// the read speed with a maximum overall memory limit (the memory budget
+	// of the dynamic buffer, see `DynBuffer::setMemoryBudget()`). It starts
+	// at `itemsOffset()` in the allocation of the buffer segment.
+	unsigned long long size{ 0 };										// The size of the `items` array.
+	unsigned long long directoryIndex{ 0 };							// The index of this buffer segment in the
+	// dynamic buffer's segment directory
+	std::chrono::steady_clock::time_point createdAt{};			// The time this buffer segment was handed to its
+	// owner, used to measure the write rate
+	std::vector<BufferSegmentOwner*> owners;				// A set of owners of this buffer segment (its capacity is kept
+	// when the buffer segment is recycled)
+	BufferSegmentOwner* currentOwner{ nullptr };		// The current owner of this buffer segment
+
+	/**
+	* Set for a buffer segment whose `items` are not in its own allocation (see `DynBuffer::adoptItems()`). It is called
+	* with `items` and `size` when the buffer segment is destroyed, instead of the items being destroyed.
+	*/
+	std::function<void(T*, unsigned long long)> releaseItems;
+
+	/**
+	* Optionally set for a buffer segment with adopted items (see `DynBuffer::adoptItems()`). It is called once, by the
+	* first reader which gets to the buffer segment (`reached` tells whether one has).
+	*/
+	std::function<void()> onReached;
+	std::atomic<bool> reached{ false };
+
+	// Written by the writer
+
+	alignas(CACHE_LINE_SIZE)
+	std::atomic<unsigned long long> writingIndex{ 0 };				// The index before which other owners have access to perform read
+	// operations. Also it is the index that is used to write to the `items`
+	// array.
+
+	/*
+	* Note that there is no special bool variable for those owners who have both read and write access. Instead, the
+	* following two variables -- `inWrite` and `inRead` are used.
+	*/
+	/**
+	* A flag variable that marks whether this buffer segment is in use and is being written to. If a thread has a
+	* lock on this buffer segment and is writing to the buffer, other threads will not be allowed to write to the same.
+	*/
+	std::atomic<bool> inWrite{ false };
+
+	/**
+	* The next buffer segment created for the `currentOwner` of this buffer segment (the writer's chain of buffer
+	* segments). It is linked only after the last items of this buffer segment have been published.
+	*/
+	std::atomic<BufferSegment<T>*> nextInChain{ nullptr };
+
+	/**
+	* Bumped by the writer when it publishes items to this buffer segment or links the next one while readers are
+	* parked on it (`parkedReaders`). See `DynBuffer::readBlocking()`.
+	*/
+	ParkingWord publications;
+
+	std::mutex writerMutex;											// A mutex for using lock on write operations
+
+	// Written by the readers
+
+	/**
+	* The number of read views (`DynBuffer::acquireRead()`) outstanding on this buffer segment. A pinned buffer segment
+	* is in use and must not be pruned. The `DROPPED_PIN` bit is set once the buffer segment is being dropped, after
+	* which it cannot be pinned anymore. Only that bit is ever cleared, never the whole word, since a reader which saw
+	* it still gives its pin back.
+	*/
+	alignas(CACHE_LINE_SIZE) std::atomic<unsigned long long> readPins{ 0 };
+
+	static constexpr unsigned long long DROPPED_PIN = 1ULL << 63;
+
+	/**
+	* A flag variable that marks whether this buffer segment is in use and is being read. The thread simply gets an
+	* access to the buffer segment without acquiring a lock on the critical section / resource. If data is being
+	* written by another thread then until that thread relinquishes its control, reading is not allowed.
+	*/
+	std::atomic<bool> inRead{ false };
+
+	std::atomic<std::uint32_t> parkedReaders{ 0 };					// The readers parked on `publications`
+
+	std::mutex readerMutex;											// A mutex for using lock on read operations
+
+	// The alignment of the allocation of a buffer segment and the offset of its `items` array in it
+	static constexpr unsigned long long ALIGNMENT = std::max<unsigned long long>(CACHE_LINE_SIZE, alignof(T));
+
+	/**
+	* @brief Destructor
+	*
+	* Calls to the destructor destroys the buffer items contained within this `BufferSegment` after and before
+	* performing necessary cleanup. The memory of the buffer segment is freed by `destroy()`.
+	*/
+	~BufferSegment() {
+		// wait for owners to finish their task on this buffer segment
+		for (typename std::vector<BufferSegmentOwner*>::iterator it = owners.begin(); it != (owners.end()); ++it) {
+			BufferSegmentOwner* pOwner = *it;
+			// Check if reference count of the owner instnace will drop to 0 after deletion
+			if (pOwner->getRefCount() == 1) {
+				// delete this owner
+				delete* it;
+				*it = nullptr;
+			}
+			else {
+				// The owner must not be deleted here. Nothing has to be waited for: the dynamic buffer stops the writer
+				// workers before it deletes its buffer segments and defers every other deletion until no reader can be
+				// looking at the buffer segment (see `EpochDomain`).
+				// Decrease the owner's reference count by 1
+				pOwner->decrementRefCount();
+			}
+		}
+		owners.clear();
+		// Remove currentOwner
+		currentOwner = nullptr;
+		if (releaseItems) {
+			// The items were adopted, hand them back to whoever provided them
+			releaseItems(items, size);
+			releaseItems = nullptr;
+		}
+		else {
+			// destroy the items written to the items array, the array goes with the buffer segment's allocation
+			destroyItems();
+		}
+		items = nullptr;
+	}
+
+	/**
+	* @brief Constructor to initialize a buffer segment of size `size` and initialize the owners set, within an
+	* allocation made by `create()`.
+	*/
+	BufferSegment(
+		unsigned long long size
+	) : items(reinterpret_cast<T*>(reinterpret_cast<std::byte*>(this) + itemsOffset())),
+		size(size),
+		currentOwner(nullptr),
+		writingIndex(0),
+		inWrite(false),
+		inRead(false) {
+		owners.reserve(2);
+	}
+
+	/**
+	* @brief Get the offset of the `items` array from the start of the allocation of a buffer segment (the header is
+	* rounded up to whole cache lines).
+	*/
+	static constexpr unsigned long long itemsOffset() {
+		return (sizeof(BufferSegment<T>) + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+	}
+
+	/**
+	* @brief Creates a buffer segment of `size` items with one allocation for its header and its `items` array.
+	*
+	* @param size The size of the buffer segment.
+	* @return Pointer to the buffer segment, freed by `destroy()`.
+	*/
+	static BufferSegment<T>* create(unsigned long long size) {
+		void* memory = ::operator new(itemsOffset() + size * sizeof(T), std::align_val_t(ALIGNMENT));
+		try {
+			return new (memory) BufferSegment<T>(size);
+		}
+		catch (...) {
+			::operator delete(memory, std::align_val_t(ALIGNMENT));
+			throw;
+		}
+	}
+
+	/**
+	* @brief Destroys a buffer segment made by `create()` and frees its allocation.
+	*/
+	static void destroy(BufferSegment<T>* bufferSeg) {
+		if (bufferSeg != nullptr) {
+			bufferSeg->~BufferSegment();
+			::operator delete(static_cast<void*>(bufferSeg), std::align_val_t(ALIGNMENT));
+		}
+	}
+
+	/**
+	* @brief Makes a drained buffer segment ready to be handed out again.
+	*
+	* The owners are removed (their reference counts are decreased but they are never deleted here since they are still
+	* in use) and the indices and flags are reset. The `items` array is kept for the next owner.
+	*
+	* The pins are left alone: the buffer segment stays marked by `tryDrop()` until no reader can try to pin it anymore
+	* (see `undrop()`), and a reader which saw the mark may still be taking its pin back.
+	*/
+	void reset() {
+		for (BufferSegmentOwner* pOwner : owners) {
+			pOwner->decrementRefCount();
+		}
+		owners.clear();
+		currentOwner = nullptr;
+		if (!releaseItems) {
+			destroyItems();
+		}
+		reached.store(false, std::memory_order_relaxed);
+		writingIndex.store(0, std::memory_order_relaxed);
+		inWrite = false;
+		inRead = false;
+		nextInChain.store(nullptr, std::memory_order_relaxed);
+	}
+
+	/**
+	* @brief Ends the lifetime of the items written to the `items` array (the ones before `writingIndex`), the array
+	* itself is kept. Nothing is done for trivially destructible `T`.
+	*/
+	void destroyItems() {
+		if constexpr (!std::is_trivially_destructible_v<T>) {
+			if (items != nullptr) {
+				std::destroy_n(items, writingIndex.load(std::memory_order_acquire));
+			}
+		}
+	}
+
+	/**
+	* @brief Get the number of bytes held by a buffer segment of `size` items: its allocation (the header and the
+	* `items` array) and its owners storage.
+	*/
+	static unsigned long long footprint(unsigned long long size) {
+		return itemsOffset() + size * sizeof(T) + 2 * sizeof(BufferSegmentOwner*);
+	}
+
+	/**
+	* @brief Pins this buffer segment for a reader.
+	*
+	* @return false if the buffer segment is being dropped and must not be read.
+	*/
+	bool tryPin() {
+		if ((readPins.fetch_add(1, std::memory_order_acq_rel) & DROPPED_PIN) != 0) {
+			readPins.fetch_sub(1, std::memory_order_acq_rel);
+			return false;
+		}
+		return true;
+	}
+
+	/**
+	* @brief Releases a pin taken by `tryPin()`.
+	*
+	* Nothing of the buffer segment is touched after the pin is released, since it may be recycled right away.
+	*/
+	void unpin() {
+		readPins.fetch_sub(1, std::memory_order_acq_rel);
+	}
+
+	/**
+	* @brief Marks this buffer segment as being dropped if no reader has pinned it.
+	*
+	* @return true if the caller may drop this buffer segment.
+	*/
+	bool tryDrop() {
+		unsigned long long expected{ 0 };
+		return readPins.compare_exchange_strong(expected, DROPPED_PIN, std::memory_order_acq_rel);
+	}
+
+	/**
+	* @brief Clears the mark set by `tryDrop()`, the pins taken back meanwhile are kept count of.
+	*/
+	void undrop() {
+		readPins.fetch_sub(DROPPED_PIN, std::memory_order_acq_rel);
+	}
+
+	/**
+	* @brief Hands a reset buffer segment to its new owner
+	*
+	* @param pOwner Pointer to the owner (a `BufferSegmentOwner`)
+	*/
+	void assignOwner(BufferSegmentOwner* pOwner) {
+		currentOwner = pOwner;
+		owners.push_back(pOwner);
+		// increment the reference count
+		pOwner->incrementRefCount();
+	}
+
+	/**
+	* @brief Get the buffer segment size
+	*
+	* @return Size of this buffer segment.
+	*/
+	int getBufferSegmentSize() {
+		return size;
+	}
+
+	/**
+	* @brief Assigns a new owner to this buffer segment
+	*
+	* @param pOwner Pointer to the owner (a `BufferSegmentOwner`)
+	*/
+	void ownBufferSegment(BufferSegmentOwner* pOwner) {
+		// Check if this owner (pOwner) has a valid ID
+		if (pOwner->getID() == INVALID_ID) {
+			throw std::runtime_error("ERR -- owner rejected -- invalid id");
+		}
+		// Check if this owner already exists in the set of owners
+		if (!(doesOwnerExist(pOwner))) {
+			owners.push_back(pOwner);
+			// Increment reference count of the owner
+			pOwner->incrementRefCount();
+		}
+		else {
+			throw std::runtime_error("ERR -- owner rejected -- owner already present");
+		}
+	}
+
+	/**
+	* @brief Checks if the owner exists for this buffer segment
+	*
+	* @param pOwner Pointer to the owner (a `BufferSegmentOwner`)
+	*/
+	bool doesOwnerExist(BufferSegmentOwner* pOwner) {
+		if (pOwner != nullptr) {
+			auto ownerID = pOwner->getID();
+			// Read all owners
+			for (auto it = owners.begin(); it != owners.end(); ++it) {
+				// Iterate through the set to find an owner with the matching ID
+				if (*it != nullptr && ((*it)->getID()) == ownerID) {
+					return true;
+				}
+			}
+			return false;
+		}
+		else {
+			throw std::runtime_error("ERR -- pOwner does not exist (nullptr)");
+		}
+	}
+
+	/**
+	 * @brief Checks whether two owners are equal by comparing their IDs.
+	 *
+	 * @param o1 The first parameter for BufferSegmentOwner.
+	 * @param o2 The second parameter for BufferSegmentOwner.
+	 * @return true If both the owners match, false otherwise
+	 */
+	bool doOwnersMatch(BufferSegmentOwner* o1, BufferSegmentOwner* o2) {
+		return o1->getID() == o2->getID();
+	}
+
+	/**
+	* @brief Revokes ownership of this buffer segment frome owner given by parameter `pOwner`
+	*
+	* Any task being performed by this owner will need to be completed before ownership is revoked.
+	*
+	* @param pOwner Pointer to the owner (a `BufferSegmentOwner`)
+	*/
+	void revokeOwnership(BufferSegmentOwner* pOwner) {
+		try {
+			// Check if the requested owner exists in relation to this buffer segment
+			bool doesOwnerExists = doesOwnerExist(pOwner);
+			if (doesOwnerExists) {
+				// Check the reference count of the owner
+				if (pOwner->getRefCount() == 1) {
+					// Check if pOwner is the currentOwner
+					if (doOwnersMatch(pOwner, currentOwner)) {
+						// nullify current owner
+						currentOwner = nullptr;
+					}
+					// Decrease the reference count by 1
+					pOwner->decrementRefCount();
+					// Remove owner from the set of owners for this buffer segment
+					std::erase(owners, pOwner);
+					// Delete the owner (the destructor of `BufferSegmentOwner` handles its thread task completion and
+					// deletion, so, no explicit or double deletion has to be done here for that.
+					delete pOwner;
+				}
+				else {
+					// There are more buffer segments having this ownership
+					// Hence, remove only the owner after all its task is finished on this buffer segment
+					pOwner->flushWriterWorker();
+					// Decrease the reference count by 1
+					pOwner->decrementRefCount();
+					// Remove owner from the set of owners for this buffer segment
+					std::erase(owners, pOwner);
+				}
+			}
+		}
+		catch (const std::runtime_error& RE) {
+			throw RE; // re-throw to the caller
+		}
+	}
+
+	/**
+	* @brief Checks if this buffer segment is in use.
+	*
+	* The read views (`DynBuffer::acquireRead()`) are counted by `readPins`, a buffer segment is no longer in use for
+	* them once they are released.
+	*
+	* @return `true` if this buffer segment is in use else `false`
+	*/
+	bool isBufferSegmentInUse() {
+		return inRead || inWrite || readPins != 0;
+	}
+
+	/**
+	* @brief Check whether this buffer segment is being read.
+	*
+	* @return true if this buffer segment is being read.
+	*/
+	bool isReading() const {
+		return (readPins.load(std::memory_order_acquire) & ~DROPPED_PIN) != 0;
+	}
+
+	/**
+	* @brief Check whether this buffer segment is being written to.
+	*
+	* @return true if any piece of data is being written to this buffer segment.
+	*/
+	bool isWriting() const {
+		return inWrite;
+	}
+
+	/**
+	* @brief Checks if this buffer segment is writable or not.
+	*
+	* @return true if this buffer segment is writable, false otherwise.
+	*/
+	bool isWritable() {
+		return
+			!inWrite								// Places the condition that when an owner is writing to this
+			// buffer segment, no other owners are allowed to write to the
+			// same.
+			||
+			(writingIndex == 0);				// Places the condition that if there are contents already
+		// written to this buffer segment and the reader associated with
+		// the writer has not finished/started reading. The reader
+		// associated with the writer is responsible to clear the buffer
+		// segment `items` array and reset the `writingIndex` to zero(0).
+		// The associated reader will read quickly, detach, return contents
+		// and wait for other reader owners to finish reading the contents
+		// of this buffer segment and then the associated reader thread will
+		// join.
+	}
+};
+
+/**
+* @brief The buffer segments owned by one owner in a dynamic buffer, in the order of the buffer.
+*
+* Every owner has its own index (and its own lock), so producers writing with different owners do not share any lock
+* when they add buffer segments.
+*/
+template <typename T> class alignas(CACHE_LINE_SIZE) OwnedSegmentIndex : public OwnerSegmentIndex {
+public:
+
+	template <typename D, typename Policy> friend class DynBuffer;
+
+private:
+
+	std::shared_mutex mutex;							// Exclusive when adding/removing, shared when looking up
+	std::vector<BufferSegment<T>*> segments;			// The buffer segments owned by the owner
+	unsigned long long recycled{ 0 };					// The number of the owner's oldest buffer segments recycled so
+	// far. The `index`-th buffer segment of the owner is `segments[index - recycled]`.
+	std::vector<BufferSegmentOwner*> readers;			// The readers attached to the owner's stream (they share this
+	// index)
+
+	ParkingWord appended;								// Bumped when a buffer segment is added while readers are
+	// parked on this index (`parkedReaders`), i.e. while the owner has no buffer segment to read
+	std::atomic<std::uint32_t> parkedReaders{ 0 };
+
+	// Adaptive sizing statistics, updated by the owner's writer only (see `DynBuffer::nextSegmentSize()`)
+	double writeRate{ 0.0 };							// EWMA of the items written per millisecond
+	double readerLag{ 0.0 };							// EWMA of the buffer segments written but not read yet
+	bool hasStatistics{ false };						// Whether the averages have been seeded
+};
+
+/**
+* @brief The state of the single-producer/single-consumer protocol between the writer and the reader of a pair created
+* by `BufferSegmentOwner::getReaderWriterPair()`.
+*
+* The writer writes straight into its last buffer segment and publishes `writingIndex` with release semantics; the
+* reader loads it with acquire semantics and follows `BufferSegment::nextInChain` to the next buffer segment. No lock
+* is taken on either side. Each side caches what it knows (the writer its tail and writing index, the reader its head
+* and the last published `writingIndex` it has seen) on its own cache line, so the shared atomics are touched only
+* when the cached values run out.
+*
+* The channel takes the place of the writer worker of the writer, as the writes are published synchronously.
+*/
+template <typename T> class SpscChannel : public OwnerWorker {
+public:
+
+	template <typename D, typename Policy> friend class DynBuffer;
+
+	void flush() override {}	// Nothing is queued, every write is published when `write()` returns
+	void stop() override {}
+
+private:
+
+	struct alignas(CACHE_LINE_SIZE) Producer {
+		BufferSegment<T>* tail{ nullptr };				// The buffer segment being written
+		unsigned long long writingIndex{ 0 };			// The writer's copy of `tail->writingIndex`
+		unsigned long long size{ 0 };					// `tail->size`
+	} producer;
+
+	struct alignas(CACHE_LINE_SIZE) Consumer {
+		BufferSegment<T>* head{ nullptr };				// The buffer segment being read
+		unsigned long long readIndex{ 0 };				// The reader's cursor in `head`
+		unsigned long long published{ 0 };				// The last `head->writingIndex` seen by the reader
+	} consumer;
+};
+
+/**
+* @brief A pool of drained buffer segments kept by a dynamic buffer for reuse.
+*
+* Recycled buffer segments (reset, with their `items` array, mutexes and owners storage kept) are parked in a fixed
+* number of slots. Giving and taking are lock-free: a buffer segment is parked by a compare-exchange on an empty slot
+* and taken by exchanging the slot with nullptr. When the pool is full the buffer segment is handed back to the dynamic
+* buffer, which frees it.
+*/
+template <typename T> class SegmentPool {
+public:
+
+	static constexpr unsigned long long CAPACITY = 64;		// The maximum number of parked buffer segments
+
+	// Delete copy constructor
+	SegmentPool(const SegmentPool&) = delete;
+	// Delete assignment operator
+	SegmentPool& operator=(const SegmentPool&) = delete;
+
+	using Discard = std::function<void(BufferSegment<T>*)>;
+
+	/**
+	* @brief Constructor
+	*
+	* @param discard Frees a buffer segment the pool cannot keep (the dynamic buffer defers it until no reader is left).
+	*/
+	explicit SegmentPool(Discard discard) : discard(std::move(discard)) {}
+
+	/**
+	* @brief Destructor
+	*
+	* Deletes the buffer segments still parked.
+	*/
+	~SegmentPool() {
+		for (unsigned long long i = 0; i < CAPACITY; ++i) {
+			BufferSegment<T>::destroy(slots[i].exchange(nullptr, std::memory_order_acq_rel));
+		}
+	}
+
+	/**
+	* @brief Takes a parked buffer segment which can hold at least `size` items (and not more than twice as many).
+	*
+	* @param size The requested size of the buffer segment.
+	* @return Pointer to the reset buffer segment or nullptr if none fits.
+	*/
+	BufferSegment<T>* take(unsigned long long size) {
+		for (unsigned long long i = 0; i < CAPACITY; ++i) {
+			if (slots[i].load(std::memory_order_relaxed) == nullptr) {
+				continue;
+			}
+			BufferSegment<T>* bufferSeg = slots[i].exchange(nullptr, std::memory_order_acq_rel);
+			if (bufferSeg == nullptr) {
+				continue;
+			}
+			if (bufferSeg->size >= size && bufferSeg->size / 2 <= size) {
+				return bufferSeg;
+			}
+			// Not of the requested size, park it again
+			if (!give(bufferSeg)) {
+				discard(bufferSeg);
+			}
+		}
+		return nullptr;
+	}
+
+	/**
+	* @brief Parks a reset buffer segment.
+	*
+	* @param bufferSeg Pointer to the reset buffer segment
+	* @return false if the pool is full and the buffer segment was not parked.
+	*/
+	bool give(BufferSegment<T>* bufferSeg) {
+		for (unsigned long long i = 0; i < CAPACITY; ++i) {
+			BufferSegment<T>* expected{ nullptr };
+			if (slots[i].compare_exchange_strong(expected, bufferSeg, std::memory_order_acq_rel)) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	* @brief Takes any parked buffer segment, regardless of its size (to free its memory).
+	*
+	* @return Pointer to the reset buffer segment or nullptr if the pool is empty.
+	*/
+	BufferSegment<T>* evict() {
+		for (unsigned long long i = 0; i < CAPACITY; ++i) {
+			if (slots[i].load(std::memory_order_relaxed) == nullptr) {
+				continue;
+			}
+			BufferSegment<T>* bufferSeg = slots[i].exchange(nullptr, std::memory_order_acq_rel);
+			if (bufferSeg != nullptr) {
+				return bufferSeg;
+			}
+		}
+		return nullptr;
+	}
+
+private:
+
+	std::atomic<BufferSegment<T>*> slots[CAPACITY]{};		// The parked buffer segments
+	Discard discard;										// Frees the buffer segments the pool cannot keep
+};
+
+/**
+* @brief A chunked, append-only directory of the buffer segments of a dynamic buffer.
+*
+* Slots are grouped in chunks of `CHUNK_SIZE` which are allocated on demand and never moved, so the address of a slot is
+* stable and the `index`-th buffer segment is found with a shift and a mask in constant time.
+*
+* Appending is lock-free: a slot is claimed by an atomic fetch-add on the number of slots and the buffer segment is
+* published into it with release semantics. Looking up is wait-free: a claimed slot which is not published yet (or
+* was cleared) reads as nullptr.
+*
+* A cleared slot keeps a tombstone, so a slot which is not published yet is never mistaken for a cleared one. The chunks
+* before the oldest live buffer segment are retired (`retireChunksBefore()`) and freed once no reader can be looking
+* at them (see `EpochDomain`).
+*/
+template <typename T> class SegmentDirectory {
+public:
+
+	static constexpr unsigned long long CHUNK_BITS = 10;
+	static constexpr unsigned long long CHUNK_SIZE = 1ULL << CHUNK_BITS;		// Slots per chunk
+	static constexpr unsigned long long MAX_CHUNKS = 1024;					// Chunks per directory
+	static constexpr unsigned long long NPOS = ~0ULL;							// Index of no slot
+
+	using Slot = std::atomic<BufferSegment<T>*>;
+
+	// Delete copy constructor
+	SegmentDirectory(const SegmentDirectory&) = delete;
+	// Delete assignment operator
+	SegmentDirectory& operator=(const SegmentDirectory&) = delete;
+
+	SegmentDirectory() = default;
+
+	/**
+	* @brief Destructor
+	*
+	* Frees the chunks only. The buffer segments are deleted by the dynamic buffer.
+	*/
+	~SegmentDirectory() {
+		for (unsigned long long i = 0; i < MAX_CHUNKS; ++i) {
+			delete[] chunks[i].load(std::memory_order_relaxed);
+		}
+	}
+
+	/**
+	* @brief Appends the buffer segment at the end of the directory.
+	*
+	* @param bufferSeg Pointer to the buffer segment
+	* @return The index of the slot holding the buffer segment.
+	*/
+	unsigned long long append(BufferSegment<T>* bufferSeg) {
+		unsigned long long index = claimed.fetch_add(1, std::memory_order_acq_rel);
+		slot(index, true)->store(bufferSeg, std::memory_order_release);
+		return index;
+	}
+
+	/**
+	* @brief Get the buffer segment at `index`.
+	*
+	* @return Pointer to the buffer segment or nullptr if the slot is not published or was cleared.
+	*/
+	BufferSegment<T>* at(unsigned long long index) const {
+		BufferSegment<T>* bufferSeg = load(index);
+		return bufferSeg == tombstone() ? nullptr : bufferSeg;
+	}
+
+	/**
+	* @brief Checks whether the slot at `index` was cleared (or its chunk was retired).
+	*/
+	bool isCleared(unsigned long long index) const {
+		return index < retiredChunks.load(std::memory_order_acquire) * CHUNK_SIZE || load(index) == tombstone();
+	}
+
+	/**
+	* @brief Clears the slot at `index` (the buffer segment was removed from the buffer).
+	*/
+	void clear(unsigned long long index) {
+		Slot* pSlot = slot(index, false);
+		if (pSlot != nullptr) {
+			pSlot->store(tombstone(), std::memory_order_release);
+		}
+	}
+
+	/**
+	* @brief Unlinks the chunks whose slots are all before `index` (all cleared) and hands them to `retire`.
+	*
+	* @param index The index of the oldest slot which may not be cleared.
+	* @param retire Frees the chunk once no reader can be looking at it.
+	*/
+	void retireChunksBefore(unsigned long long index, const std::function<void(Slot*)>& retire) {
+		unsigned long long chunkIndex = retiredChunks.load(std::memory_order_acquire);
+		while ((chunkIndex + 1) * CHUNK_SIZE <= index && chunkIndex < MAX_CHUNKS) {
+			if (!(retiredChunks.compare_exchange_strong(chunkIndex, chunkIndex + 1, std::memory_order_acq_rel))) {
+				continue;	// Retired by someone else, `chunkIndex` was reloaded
+			}
+			Slot* chunk = chunks[chunkIndex].exchange(nullptr, std::memory_order_acq_rel);
+			if (chunk != nullptr) {
+				retire(chunk);
+			}
+			++chunkIndex;
+		}
+	}
+
+	/**
+	* @brief Get the number of slots claimed so far.
+	*/
+	unsigned long long size() const {
+		return claimed.load(std::memory_order_acquire);
+	}
+
+private:
+
+	std::atomic<Slot*> chunks[MAX_CHUNKS]{};			// The chunks of slots, allocated on demand
+	std::atomic<unsigned long long> claimed{ 0 };		// The number of slots claimed by `append()`
+	std::atomic<unsigned long long> retiredChunks{ 0 };	// The number of leading chunks retired
+
+	/**
+	* @brief Get the marker stored in a cleared slot.
+	*/
+	static BufferSegment<T>* tombstone() {
+		return reinterpret_cast<BufferSegment<T>*>(alignof(BufferSegment<T>));
+	}
+
+	/**
+	* @brief Get the raw content of the slot at `index` (nullptr if not published yet or its chunk is gone).
+	*/
+	BufferSegment<T>* load(unsigned long long index) const {
+		if (index >= claimed.load(std::memory_order_acquire)) {
+			return nullptr;
+		}
+		Slot* pSlot = const_cast<SegmentDirectory*>(this)->slot(index, false);
+		return pSlot == nullptr ? nullptr : pSlot->load(std::memory_order_acquire);
+	}
+
+	/**
+	* @brief Get the slot at `index`, allocating its chunk if `allocate` is true.
+	*/
+	Slot* slot(unsigned long long index, bool allocate) {
+		unsigned long long chunkIndex = index >> CHUNK_BITS;
+		if (chunkIndex >= MAX_CHUNKS) {
+			throw std::runtime_error("ERR: SEGMENT DIRECTORY FULL");
+		}
+		Slot* chunk = chunks[chunkIndex].load(std::memory_order_acquire);
+		if (chunk == nullptr) {
+			if (!allocate) {
+				return nullptr;
+			}
+			// Race the other appenders to install the chunk, the loser frees its allocation
+			Slot* fresh = new Slot[CHUNK_SIZE]{};
+			if (chunks[chunkIndex].compare_exchange_strong(chunk, fresh, std::memory_order_acq_rel)) {
+				chunk = fresh;
+			}
+			else {
+				delete[] fresh;
+			}
+		}
+		return &(chunk[index & (CHUNK_SIZE - 1)]);
+	}
+};
+
+/**
+* @class DynBuffer
+* @brief Used to create and manage a dynamic buffer
+*
+* This class employs a single thread which overlooks entire tasks inside it. For reference use the name "DynBufferThread".
+*
+* Use this class as the interface for detailed level operations on the buffer segment. This class holds more than one
+* instance of the `BufferSegment` class in a directory of `BufferSegment*` (`SegmentDirectory`).
+*
+* A dynamic buffer stores several buffer segments in a linear fashion. Some of the threads might be reading a buffer
+* segment values, some might try to write to it. So in this list of buffer segments, some owners might still be accessing
+* the buffer segment, some might have finished working with the buffer and optionally moves on to the next buffer segment
+* (watching out if they have their ownership in the next buffer segment).
+* Thus the incoming or outgoing data through the Dynamic Buffer will be stored in a continuous, linear, zero-based
+* indexing fashion so as to maintain data consistency.
+*
+* The actual purpose of having a `DynBuffer` class is to create a dynamic buffer which will allow to create more efficient
+* buffer that employs Pruner thread(s) divided among "regions" to free resources (e.g., `items` dynamic array of
+* `BufferSegment` class) and erase the `BufferSegment` instance from the list of `BufferSegment`s.
+* A buffer segment of any size can be requested and created any time the owner wants to.
+* A "region" for the Pruner threads is defined as the chunk of `BufferSegment` directory (`bufferSegments`) which will be
+* looked over by the Pruner thread employed by the `DynBuffer` dynamic buffer to cleanup the `BufferSegment`s and erase
+* that `BufferSegment` instance itself from the `bufferSegments` directory. One region (`pruneSlotsPerPass` slots) is
+* looked over per prunning pass and the passes go round the directory, so a pass never stalls the readers and writers
+* however large the buffer grows. A buffer segment read completely by all of its owners is recycled by the Pruner thread.
+*
+* NOTE 1: A buffer segment not having any active threads reading or writing does not mean that it will not have owners. If
+* it has owners, it will still remain in the memory because it is unpredictable whether the owner's thread will be used
+* again. Only when the ownership is revoked, and there are zero(0) owners to that buffer segment, the buffer segment is
+* dropped.
+* NOTE 2: Whenever a new owner arrives with a write permission, a new buffer segment is created and owned by this new
+* owner. An owner with a write permission handles writing to the buffer segments it owns single handedly and no extra
+* owner is required to write the contents that the original owner was supposed to write.
+* NOTE 3: Any number of owners can read from the buffer. There is no restriction on reading a buffer segment except when
+* another owner is writing to the buffer segment.
+* NOTE 4: If an owner has finished writing to a specific buffer segment, all other waiting owners will read from the buffer
+* when write operations are over.
+* NOTE 5: Several readers can be attached to the stream of one writer (`attachReader()`), each of them reads every item
+* of the writer at its own pace and the writer's buffer segments are pruned once the slowest of them is done with them.
+*
+* @tparam T The type of the items.
+* @tparam Policy The compile-time policy (`BufferPolicy`): how the owners' streams are shared among threads and whether
+* the capacity of the buffer segments is fixed. Whatever the policy rules out is compiled out of the writes and reads.
+*/
+template <typename T, typename Policy = BufferPolicy<>> class DynBuffer {
+
+public:
+
+	// Delete copy constructor
+	DynBuffer(const DynBuffer&) = delete;
+	// Delete assignment operator
+	DynBuffer& operator=(const DynBuffer&) = delete;
+
+	/**
+	* @brief Destructor
+	*
+	* NOTE: ORDER OF DELETION AND NON-DANGLING MATTERS THE MOST
+	*
+	* WARNING: DO NOT DELETE THIS BUFFER ITSELF
+	* THE DESTRUCTOR HAS TO BE CALLED ON AN INSTANCE OF THIS CLASS MANUALLY OR MANAGED BY A SMART POINTER
+	*/
+	~DynBuffer() {
+		// Stop the pruner first so that no buffer segment is recycled while the buffer is torn down
+		stopPruner();
+		// Stop the writer workers so that no batch is written to a buffer segment being deleted
+		{
+			std::lock_guard<std::mutex> lock(writerOwnersMutex);
+			for (BufferSegmentOwner* pOwner : writerOwners) {
+				OwnerWorker* pWorker = pOwner->writerWorker.exchange(nullptr);
+				if (pWorker != nullptr) {
+					pWorker->stop();
+					delete pWorker;
+				}
+			}
+			writerOwners.clear();
+		}
+		// Free buffer segments, clear and delete
+		for (unsigned long long index = 0; index < bufferSegments.size(); ++index) {
+			BufferSegment<T>* bufferSeg = bufferSegments.at(index);
+			// Ensure the slot is not empty before dereferencing
+			if (bufferSeg != nullptr) {
+				bufferSegments.clear(index);	// Clear the slot of the directory
+				BufferSegment<T>::destroy(bufferSeg);	// Delete the BufferSegment object
+			}
+		}
+		// Free what was retired, no reader is left
+		limbo.reclaimAll();
+		// The attached readers are owned by the buffer
+		for (BufferSegmentOwner* pReader : attachedReaders) {
+			delete pReader;
+		}
+		attachedReaders.clear();
+	}
+
+	/**
+	* @brief Default constructor to instantiate a dynamic buffer of zero size.
+	*/
+	DynBuffer() {
+		startPruner();
+	}
+
+	/**
+	* @brief Constructor to instantiate a dynamic buffer with given initial size and owner.
+	*
+	* @param initialSize The size of the buffer segment at the time of instantiation of dynamic buffer
+	* (single buffer segment is created)
+	* @param pOwner Pointer to the owner of the buffer segment to be assigned to the buffer segment
+	*/
+	DynBuffer(int initialSize, BufferSegmentOwner* pOwner) {
+		// Assign ID to the owner
+		pOwner->assignUID();
+		// Add a buffer to start with size of the buffer segment as `initialSize`
+		createBufferSegment(initialSize, pOwner);
+		startPruner();
+	}
+
+	/**
+	* @brief Constructor to instantiate a dynamic buffer with give initial size and owner with multiple
+	* buffer segments
+	*
+	* Note that this constructor will be used rarely.
+	*
+	* @param initialSize The size of the buffer segment at the time of instantiation of dynamic buffer
+	* (multiple buffer segements are created)
+	* @param pOwner Pointer to the owner of the buffer segment to be assigned to the buffer segment
+	* @param counts The number of buffer segments to create
+	*/
+	DynBuffer(
+		int initialSize, BufferSegmentOwner* pOwner, int counts
+	) {
+		// Assign ID to the owner
+		pOwner->assignUID();
+		// add `counts` number of buffer segments to the buffer segment directory (`bufferSegments`) of size
+		// `initialSize` with their owner `pOwner`
+		while (counts > 0) {
+			createBufferSegment(initialSize, pOwner);
+			--counts;
+		}
+		startPruner();
+	}
+
+	/**
+	* @brief This function is used for any mixed use/operation on the buffer.
+	*
+	* The owner is verified before any operation is performed on the buffer.
+	* If there exists no owner as such then this owner will have the ownerhip of the buffer.
+	*
+	* In a write operation or a read and write operations, if, immediately there is a "busy" buffer segment in the
+	* succession or when the next buffer has some owners with read permission then the next buffer segment is not
+	* touched for write operation or read and write operations.Rather, a buffer segment in the list is added,
+	* owner is assined, current owner is set, and a pointer to it is returned immediately for write or read and
+	* write operations. Data is written. If the data being written doesn't fit in, a new buffer segment is created
+	* of the same size and the process is repeated.
+	*
+	* @param pOwner Pointer to the owner of the buffer segment in use
+	* @param func The function to execute with the buffer.
+	* @param lambdaArgs The arguments to pass to the function.
+	* @return The result (R) of the function execution.
+	*/
+	// TODO
+	template <
+		typename R,                              // Return Type
+		typename... Args>                        // Lambda Arguments Types
+	R use(BufferSegmentOwner* pOwner, std::function<R(Args...)> func, Args&&... lambdaArgs) {
+		try {
+			// Check if the owner has its ID
+			if (!(pOwner->hasUID())) {
+				// The owner's ID does not exist. Assign an ID to it.
+				pOwner->assignUID();
+				// Certainly it did not own a buffer segment, since an owner without an ID can not own a buffer
+				// segment.
+				// Create new buffer segment and assign the owner.
+				createBufferSegment(nextSegmentSize(pOwner, nullptr), pOwner); // TODO:
+				// Arrange defaults for various operations: Terminal I/O, Application I/O, File I/O, Networking:
+				// Mobile Data, Bluetooth, WiFi
+			}
+			else if (pOwner->broadcastWriter == nullptr && lastOwnedSegment(pOwner) == nullptr) {
+				// No buffer segment with this owner found, create one and assign this owner
+				createBufferSegment(nextSegmentSize(pOwner, nullptr), pOwner); // TODO:
+				// Arrange defaults for various operations: Terminal I/O, Application I/O, File I/O, Networking:
+				// Mobile Data, Bluetooth, WiFi
+			}
+			// Now it is sure that owner exists with its buffer segment
+			/*
+			* WARNING: DO NOT USE DIRECT LOCKS ON ANY RESOURCE/CRITICAL SECTION WITHIN THIS `use` FUNCTION. THE
+			* LOCKING ON RESOURCES ARE TO BE DONE BY OTHER FUNCTIONS AND OVERLOADED OPERATORS SUCH AS WRITE,
+			* READ, +, -, << (READ IN), >> (READ OUT), ETC. AND THESE SPECIFIED FUNCTIONS ARE USED ONLY WITHIN THE
+			* PROVIDED LAMBDA IN THE ARGUMENTS. USE OF FUNCTIONS ASSOCIATED WITH MODIFICATION OF BUFFER SEGMENT
+			* AND FUNCTIONS THAT ALLOW READING OF DATA FROM A BUFFER SEGMENT ARE RESPONSIBLE FOR SETTING THE
+			* `INWRITE` AND `INREAD` BOOL VARIABLES BY USE OF LOCK.
+			*/
+
+			// Execute the function
+			if constexpr (std::is_same_v<R, void>) {
+				std::invoke(func, std::forward<Args>(lambdaArgs)...);
+			}
+			else {
+				return std::invoke(func, std::forward<Args>(lambdaArgs)...);
+			}
+		}
+		catch (const std::exception& e) {
+			// re-throw to the caller
+			throw e;
+		}
+	}
+
+	/**
+	* @brief Submits a single item to be written to that buffer segment whose `writingIndex` has not exhausted and the
+	* owner of that buffer segment is `*pOwner`.
+	*
+	* The item is only enqueued on the owner's long-lived writer worker, which is started on the first write of the
+	* owner. The worker writes the queued items to the buffer segments in batches. This function blocks only while the
+	* owner's submission queue is full. Use `flush()` to wait until the submitted items are readable.
+	*
+	* The writer of a reader-writer pair (`BufferSegmentOwner::getReaderWriterPair()`) does not use a worker. Its items
+	* are written and published right away through the lock-free single-producer/single-consumer protocol.
+	*
+	* No need to dynamically manage the size of the buffer segment here. If new buffer segment is required, a new
+	* buffer segment of required size will be created with the same owner and write access.
+	*/
+	void write(const T& item, BufferSegmentOwner* pOwner) {
+		emplace(pOwner, item);
+	}
+
+	/**
+	* @brief Submits a single item to be written, moving it instead of copying it (see `write(const T&, ...)`).
+	*/
+	void write(T&& item, BufferSegmentOwner* pOwner) {
+		emplace(pOwner, std::move(item));
+	}
+
+	/**
+	* @brief Submits a single item constructed from `args` to be written (see `write(const T&, ...)`).
+	*
+	* The writer of a reader-writer pair (and every writer of a `BUFFER_CONCURRENCY::SPSC` buffer) constructs the item
+	* right in its buffer segment. Other owners construct it in their writer worker's submission queue, from where it is
+	* moved to the buffer segment.
+	*
+	* @param pOwner Pointer to the owner with write access
+	* @param args The arguments of the constructor of `T`.
+	*/
+	template <typename... Args> void emplace(BufferSegmentOwner* pOwner, Args&&... args) {
+		validateWriter(pOwner);
+		if (SINGLE_PRODUCER || pOwner->isPartOfReaderWriterPair) {
+			spscEmplace(pOwner, std::forward<Args>(args)...);
+			return;
+		}
+		writerWorkerOf(pOwner)->emplace(std::forward<Args>(args)...);
+	}
+
+	/**
+	* @brief Writes a burst of items to the buffer segments owned by `*pOwner`.
+	*
+	* The last buffer segment of the owner is resolved once and filled with a single copy (`memcpy` for trivially
+	* copyable `T`). New buffer segments are created only when the items spill over a buffer segment boundary, and the
+	* `writerMutex` of every buffer segment is taken once for all the items copied into it.
+	*
+	* Items submitted earlier through `write(const T&, BufferSegmentOwner*)` are written before this burst. Unlike the single
+	* item overload, this function returns only after the items are readable.
+	*
+	* @param items The items to be written.
+	* @param pOwner Pointer to the owner with write access
+	*/
+	void write(std::span<const T> items, BufferSegmentOwner* pOwner) {
+		validateWriter(pOwner);
+		// Keep the order with the items already queued on the owner's writer worker
+		pOwner->flushWriterWorker();
+		appendItems(items.data(), items.size(), pOwner);
+		syncSpscProducer(pOwner);
+	}
+
+	/**
+	* @brief Appends `count` items which live outside the buffer (e.g. the pages of a mapped file) to the buffer
+	* segments owned by `*pOwner`, without copying them.
+	*
+	* A buffer segment is created around the items and published whole: it is read like any other buffer segment of the
+	* owner but is never written to, the next write of the owner starts a new buffer segment. Only its header is charged
+	* to the memory budget. When the buffer segment has been read and is pruned (or when the buffer is destroyed),
+	* `release` is called with `items` and `count` once no reader can be looking at them anymore. It is called from the
+	* thread that frees the buffer segment (usually the pruner thread).
+	*
+	* `reached`, if set, is called once by the first reader which gets to the buffer segment, from the reader's thread
+	* (e.g. to read ahead of the readers).
+	*
+	* @param pOwner Pointer to the owner with write access
+	* @param items The items, they must stay valid and unchanged until `release` is called.
+	* @param count The number of items.
+	* @param release Gives the items back to whoever provided them.
+	* @param reached Called when the readers get to the items.
+	*/
+	void adoptItems(
+		BufferSegmentOwner* pOwner,
+		T* items,
+		unsigned long long count,
+		std::function<void(T*, unsigned long long)> release,
+		std::function<void()> reached = {}
+	) requires (Policy::segmentCapacity == 0) {
+		validateWriter(pOwner);
+		if (items == nullptr || count == 0 || !release) {
+			throw std::runtime_error("ERR: ADOPT FAILED -- NO ITEMS TO ADOPT");
+		}
+		// Keep the order with the items already queued on the owner's writer worker
+		pOwner->flushWriterWorker();
+		{
+			AppendLock appendLock(pOwner->appendMutex);
+			if (pOwner->reservedItems != 0) {
+				throw std::runtime_error("ERR: ADOPT FAILED -- OWNER HAS AN OUTSTANDING RESERVATION");
+			}
+			BufferSegment<T>* bufferSeg = BufferSegment<T>::create(0);
+			memoryInUse.fetch_add(BufferSegment<T>::footprint(0), std::memory_order_acq_rel);
+			bufferSeg->items = items;
+			bufferSeg->size = count;
+			bufferSeg->releaseItems = std::move(release);
+			bufferSeg->onReached = std::move(reached);
+			// Full before it is linked, so that it is published whole and nobody writes to it
+			bufferSeg->writingIndex.store(count, std::memory_order_release);
+			linkBufferSegment(bufferSeg, pOwner);
+		}
+		syncSpscProducer(pOwner);
+	}
+
+	/**
+	* @brief Blocks until every item submitted by `pOwner` through `write()` has been written to the buffer.
+	*
+	* @param pOwner Pointer to the owner whose submissions are to be flushed.
+	*/
+	void flush(BufferSegmentOwner* pOwner) {
+		if (pOwner == nullptr) {
+			throw std::runtime_error("ERR: OWNER NOT FOUND -- nullptr");
+		}
+		pOwner->flushWriterWorker();
+	}
+
+	/**
+	* @brief Sets the bounds and tuning of the adaptive sizing of new buffer segments.
+	*
+	* @param policy The sizing policy, `minSize` must not be greater than `maxSize`.
+	*/
+	void setSegmentSizingPolicy(const SegmentSizingPolicy& policy) {
+		if (policy.minSize == 0 || policy.minSize > policy.maxSize || policy.smoothing <= 0.0 || policy.smoothing > 1.0) {
+			throw std::runtime_error("ERR: INVALID SEGMENT SIZING POLICY");
+		}
+		sizingPolicy = policy;
+	}
+
+	/**
+	* @brief Get the bounds and tuning of the adaptive sizing of new buffer segments.
+	*/
+	SegmentSizingPolicy getSegmentSizingPolicy() const {
+		return sizingPolicy;
+	}
+
+	/**
+	* @brief Bounds the memory held by the buffer segments of this buffer (their items and their metadata, including
+	* the drained buffer segments kept for reuse) to `bytes`.
+	*
+	* When a new buffer segment would not fit in the budget, the drained buffer segments kept for reuse are freed
+	* first. If that is not enough the `policy` decides (see `BUFFER_OVERFLOW_POLICY`). Only the buffer segments read
+	* completely are drained, so with `BUFFER_OVERFLOW_POLICY::BLOCK` the writer waits for its reader. The buffer
+	* segments of reader-writer pairs are never dropped by `BUFFER_OVERFLOW_POLICY::DROP_OLDEST` (their reader does not
+	* pin them), the newest items are dropped instead when nothing else can be dropped.
+	*
+	* The buffer segments are sized to fit in the budget. Writers blocked on the old budget are woken up.
+	*
+	* @param bytes The memory budget in bytes (unlimited by default).
+	* @param policy What a write does when the budget is exhausted.
+	*/
+	void setMemoryBudget(unsigned long long bytes, BUFFER_OVERFLOW_POLICY policy) {
+		if (bytes < BufferSegment<T>::footprint(1)) {
+			throw std::runtime_error("ERR: INVALID MEMORY BUDGET -- SMALLER THAN A BUFFER SEGMENT");
+		}
+		memoryBudget.store(bytes, std::memory_order_release);
+		overflowPolicy.store(policy, std::memory_order_release);
+		notifyMemoryReleased();
+	}
+
+	/**
+	* @brief Get the memory budget in bytes.
+	*/
+	unsigned long long getMemoryBudget() const {
+		return memoryBudget.load(std::memory_order_acquire);
+	}
+
+	/**
+	* @brief Get the policy applied when the memory budget is exhausted.
+	*/
+	BUFFER_OVERFLOW_POLICY getOverflowPolicy() const {
+		return overflowPolicy.load(std::memory_order_acquire);
+	}
+
+	/**
+	* @brief Get the number of bytes held by the buffer segments of this buffer.
+	*/
+	unsigned long long getMemoryInUse() const {
+		return memoryInUse.load(std::memory_order_acquire);
+	}
+
+	/**
+	* @brief Get the number of items dropped so far by the `DROP_OLDEST` and `DROP_NEWEST` overflow policies.
+	*/
+	unsigned long long getDroppedItems() const {
+		return droppedItems.load(std::memory_order_acquire);
+	}
+
+	/**
+	* @brief Get the generation of the memory of this buffer, bumped every time memory may have become available (a
+	* buffer segment was drained or freed, or the memory budget was changed). Read it before trying to take memory and
+	* pass it to `waitForMemoryReleased()` when the attempt failed.
+	*/
+	unsigned long long getMemoryGeneration() const {
+		return memoryGeneration.load(std::memory_order_acquire);
+	}
+
+	/**
+	* @brief Waits at most `timeout` until memory may have become available after `generation` was read (see
+	* `getMemoryGeneration()`), e.g. for a writer whose items were dropped by the overflow policy.
+	*
+	* @param generation The generation read before the attempt to take memory.
+	* @param timeout The maximum time to wait.
+	* @return false if nothing was released in time.
+	*/
+	template <typename Rep, typename Period>
+	bool waitForMemoryReleased(unsigned long long generation, const std::chrono::duration<Rep, Period>& timeout) {
+		blockedWriters.fetch_add(1);
+		requestPrune();
+		bool released{ false };
+		{
+			std::unique_lock<std::mutex> lock(memoryMutex);
+			released = memoryReleased.wait_for(lock, timeout, [this, generation]() {
+				return memoryGeneration.load() != generation;
+			});
+		}
+		blockedWriters.fetch_sub(1);
+		return released;
+	}
+
+	/**
+	* @brief Requests a prunning pass from the pruner thread engine without waiting for the current interval to end.
+	*
+	* Passes also run every prunning interval (`setPruneInterval()`) and right away when a write would exceed the
+	* memory budget.
+	*/
+	void requestPrune() {
+		{
+			std::lock_guard<std::mutex> lock(prunerMutex);
+			pruneRequested = true;
+		}
+		prunerWakeup.notify_one();
+	}
+
+	/**
+	* @brief Sets the time interval between two prunning passes.
+	*
+	* @param milliseconds The interval in milliseconds (default : 2000ms).
+	*/
+	void setPruneInterval(unsigned long long milliseconds) {
+		if (milliseconds == 0) {
+			throw std::runtime_error("ERR: INVALID PRUNE INTERVAL");
+		}
+		intervalMS.store(milliseconds);
+		requestPrune();
+	}
+
+	/**
+	* @brief Attaches a new reader to the stream of `pWriter`.
+	*
+	* Every reader attached to a writer reads all of the writer's items on its own, at its own pace, from the same
+	* buffer segments (nothing is copied). It starts at the oldest buffer segment of the writer still in the buffer and
+	* is used like any other owner with read access (`tryRead()`, `readBlocking()`, `acquireRead()`, ...). While a
+	* writer has readers attached, its buffer segments are pruned once the slowest of them has read them and the
+	* writer's own read position is not looked at.
+	*
+	* A reader falling behind the writer by more than `maxLagSegments` buffer segments stops holding back the pruning
+	* as per `lagPolicy`.
+	*
+	* The reader is owned by the buffer, it is deleted by `detachReader()` or with the buffer.
+	*
+	* @param pWriter Pointer to the writer, which must not be part of a reader-writer pair
+	* @param name The name of the reader
+	* @param maxLagSegments The lag limit in buffer segments (0 : unlimited, the reader holds back the pruning forever)
+	* @param lagPolicy What happens to the reader once it is over the lag limit
+	* @return Pointer to the attached reader.
+	*/
+	BufferSegmentOwner* attachReader(
+		BufferSegmentOwner* pWriter, std::string name = "", unsigned long long maxLagSegments = 0,
+		READER_LAG_POLICY lagPolicy = READER_LAG_POLICY::DETACH
+	) requires (Policy::concurrency == BUFFER_CONCURRENCY::MPMC) {
+		return attachCursor(pWriter, name, maxLagSegments, lagPolicy, false, 0);
+	}
+
+	/**
+	* @brief Creates a consumer group on the stream of `pWriter`.
+	*
+	* The workers of a consumer group (`joinConsumerGroup()`) drain the writer's stream together, every item is handed
+	* out to exactly one of them. A worker claims a slice of at most `sliceItems` items from the buffer segment being
+	* drained with a single atomic operation on the group's claim cursor, no lock is shared among the workers. The group
+	* holds back the pruning like a reader attached by `attachReader()` does (as far as its slices are handed out, a
+	* slice is pinned until its worker releases it).
+	*
+	* The group itself is not read from, its workers are. The buffer segments must not hold more than 2^32 items.
+	*
+	* @param pWriter Pointer to the writer, which must not be part of a reader-writer pair
+	* @param name The name of the group
+	* @param sliceItems The most items handed out by one claim (0 : everything published in the buffer segment, i.e.
+	* whole buffer segments once they are written)
+	* @param maxLagSegments The lag limit in buffer segments (0 : unlimited)
+	* @param lagPolicy What happens to the group once it is over the lag limit
+	* @return Pointer to the consumer group.
+	*/
+	BufferSegmentOwner* createConsumerGroup(
+		BufferSegmentOwner* pWriter, std::string name = "", unsigned long long sliceItems = 0,
+		unsigned long long maxLagSegments = 0, READER_LAG_POLICY lagPolicy = READER_LAG_POLICY::DETACH
+	) requires (Policy::concurrency == BUFFER_CONCURRENCY::MPMC) {
+		return attachCursor(pWriter, name, maxLagSegments, lagPolicy, true, sliceItems);
+	}
+
+	/**
+	* @brief Adds a worker to a consumer group created by `createConsumerGroup()`.
+	*
+	* The worker is used like any other owner with read access (`tryRead()`, `readBlocking()`, `acquireRead()`, ...),
+	* every read claims the items from the group. The view returned by `acquireRead()` is handed out to this worker
+	* only, the items of the view not released by `releaseRead()` are not handed out again.
+	*
+	* The worker is owned by the buffer, it is deleted by `detachReader()` or with the buffer.
+	*
+	* @param pGroup Pointer to the consumer group
+	* @param name The name of the worker
+	* @return Pointer to the worker.
+	*/
+	BufferSegmentOwner* joinConsumerGroup(BufferSegmentOwner* pGroup, std::string name = "") requires (Policy::concurrency == BUFFER_CONCURRENCY::MPMC) {
+		if (pGroup == nullptr || !(pGroup->isConsumerGroup)) {
+			throw std::runtime_error("ERR: JOIN FAILED -- NOT A CONSUMER GROUP");
+		}
+		BufferSegmentOwner* pWorker = new BufferSegmentOwner(name, BUFFER_SEGMENT_ACCESS_LEVEL::READ);
+		pWorker->assignUID();
+		pWorker->broadcastWriter = pGroup->broadcastWriter;
+		pWorker->consumerGroup = pGroup;
+		{
+			std::lock_guard<std::mutex> lock(attachedReadersMutex);
+			if (std::find(attachedReaders.begin(), attachedReaders.end(), pGroup) == attachedReaders.end()) {
+				delete pWorker;
+				throw std::runtime_error("ERR: JOIN FAILED -- CONSUMER GROUP NOT ATTACHED TO THIS BUFFER");
+			}
+			++(pGroup->groupWorkers);
+			attachedReaders.push_back(pWorker);
+		}
+		pWorker->segmentIndex.store(pGroup->segmentIndex.load(std::memory_order_acquire), std::memory_order_release);
+		return pWorker;
+	}
+
+	/**
+	* @brief Detaches and deletes a reader attached by `attachReader()`, a consumer group (once its workers are
+	* detached) or a worker of a consumer group.
+	*
+	* Must not be called while the reader is being used by another thread. Its outstanding read view, if any, is
+	* released.
+	*
+	* @param pReader Pointer to the attached reader
+	*/
+	void detachReader(BufferSegmentOwner* pReader) {
+		if (pReader == nullptr || pReader->broadcastWriter == nullptr) {
+			throw std::runtime_error("ERR: DETACH FAILED -- NOT AN ATTACHED READER");
+		}
+		{
+			std::lock_guard<std::mutex> lock(attachedReadersMutex);
+			auto position = std::find(attachedReaders.begin(), attachedReaders.end(), pReader);
+			if (position == attachedReaders.end()) {
+				throw std::runtime_error("ERR: DETACH FAILED -- READER NOT ATTACHED TO THIS BUFFER");
+			}
+			if (pReader->groupWorkers != 0) {
+				throw std::runtime_error("ERR: DETACH FAILED -- CONSUMER GROUP HAS WORKERS");
+			}
+			if (pReader->consumerGroup != nullptr) {
+				--(pReader->consumerGroup->groupWorkers);
+			}
+			attachedReaders.erase(position);
+		}
+		OwnedSegmentIndex<T>* pIndex = segmentIndexOf(pReader, false);
+		{
+			std::unique_lock<std::shared_mutex> lock(pIndex->mutex);
+			auto position = std::find(pIndex->readers.begin(), pIndex->readers.end(), pReader);
+			if (position != pIndex->readers.end()) {
+				pIndex->readers.erase(position);	// Workers of a consumer group are not listed
+			}
+		}
+		if (pReader->readViewSegment != nullptr) {
+			static_cast<BufferSegment<T>*>(pReader->readViewSegment)->unpin();
+		}
+		for (std::pair<void*, unsigned long long>& view : pReader->readViews) {
+			static_cast<BufferSegment<T>*>(view.first)->unpin();
+		}
+		delete pReader;
+		// What it held back may be prunable now
+		requestPrune();
+	}
+
+	/**
+	* @brief Checks whether an attached reader was detached for falling behind (`READER_LAG_POLICY::DETACH`).
+	*/
+	bool isDetached(BufferSegmentOwner* pReader) const {
+		if (pReader->consumerGroup != nullptr) {
+			pReader = pReader->consumerGroup;
+		}
+		return pReader->detached.load(std::memory_order_acquire);
+	}
+
+	/**
+	* @brief Get the number of buffer segments an attached reader skipped (`READER_LAG_POLICY::SKIP`), they were
+	* pruned before it read them.
+	*/
+	unsigned long long getSkippedSegments(BufferSegmentOwner* pReader) const {
+		return pReader->skippedSegments.load(std::memory_order_acquire);
+	}
+
+	/**
+	* @brief Checks if there is next item avaialable to be read from the buffer.
+	*
+	* @return true if there are items to be read from the buffer.
+	*/
+	bool hasNext(BufferSegmentOwner* pOwner) {
+		// Check if the owner is a valid owner
+		if (pOwner == nullptr) {
+			throw std::runtime_error("ERR: OWNER NOT FOUND -- nullptr");
+		}
+		if (isSpscReader(pOwner)) {
+			return !(spscAcquireRead(pOwner, 1).empty());
+		}
+		if constexpr (!SINGLE_CONSUMER) {
+			if (pOwner->consumerGroup != nullptr) {
+				return hasUnclaimed(pOwner->consumerGroup);
+			}
+			validateAttachedReader(pOwner);
+		}
+		// Check if the buffer segment being read has been read upto the published `writingIndex` or not
+		EpochGuard guard;
+		BufferSegment<T>* segInRead = currentReadSegment(pOwner);
+		return segInRead != nullptr &&
+			(pOwner->bufferSegmentItemsArrayReadIndex) < segInRead->writingIndex.load(std::memory_order_acquire);
+	}
+
+	/**
+	* @brief Reads the next item from the current/next buffer segment owned by pOwner
+	*
+	* Only the items published by the writer (the ones before `writingIndex`) are read.
+	*/
+	const T read(BufferSegmentOwner* pOwner) {
+		std::optional<T> item = tryRead(pOwner);
+		if (!(item.has_value())) {
+			throw std::runtime_error("ERR: NO BUFFER ENTRY FOR OWNER : " + std::to_string((unsigned long long)((void*)pOwner)));
+		}
+		return std::move(*item);
+	}
+
+	/**
+	* @brief Reads the next item if one is available, without waiting.
+	*
+	* @param pOwner Pointer to the owner of the buffer segments to be read.
+	* @return The item, or no value if nothing has been published yet.
+	*/
+	std::optional<T> tryRead(BufferSegmentOwner* pOwner) {
+		std::span<const T> view = acquireRead(pOwner, 1);
+		if (view.empty()) {
+			return std::nullopt;
+		}
+		T item = view[0];
+		releaseRead(pOwner, 1);
+		return item;
+	}
+
+	/**
+	* @brief Reads the next item, waiting for the writer to publish one if needed.
+	*
+	* The owner first polls for a while (adapted to how long it usually waits, see `BufferSegmentOwner::readSpins`) and
+	* then parks on the buffer segment it reads until the writer publishes to it or links the next one. A parked owner
+	* costs no CPU, and the writer wakes it right after publishing.
+	*
+	* @param pOwner Pointer to the owner of the buffer segments to be read.
+	* @return The item.
+	*/
+	T readBlocking(BufferSegmentOwner* pOwner) {
+		while (true) {
+			std::optional<T> item = tryRead(pOwner);
+			if (item.has_value()) {
+				return std::move(*item);
+			}
+			waitForData(pOwner, std::nullopt);
+		}
+	}
+
+	/**
+	* @brief Reads the next item, waiting at most `timeout` for the writer to publish one (see `readBlocking()`).
+	*
+	* @param pOwner Pointer to the owner of the buffer segments to be read.
+	* @param timeout The maximum time to wait.
+	* @return The item, or no value if nothing was published in time.
+	*/
+	template <typename Rep, typename Period>
+	std::optional<T> readFor(BufferSegmentOwner* pOwner, const std::chrono::duration<Rep, Period>& timeout) {
+		std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() +
+			std::chrono::ceil<std::chrono::steady_clock::duration>(timeout);
+		while (true) {
+			std::optional<T> item = tryRead(pOwner);
+			if (item.has_value()) {
+				return item;
+			}
+			if (!waitForData(pOwner, deadline)) {
+				return tryRead(pOwner);
+			}
+		}
+	}
+
+	/**
+	* @brief Provides a read only view on the items currently readable by `pOwner` in its current buffer segment,
+	* without copying them.
+	*
+	* The view covers at most `maxItems` items starting at the owner's read index and ends at the `writingIndex`
+	* published by the writer. When the current buffer segment has been read completely and the writer has moved on
+	* to a newer buffer segment, the owner advances to that buffer segment first.
+	*
+	* The buffer segment is pinned (it is not pruned) until `releaseRead()` is called. Only one view per owner can be
+	* outstanding.
+	*
+	* @param pOwner Pointer to the owner of the buffer segments to be read.
+	* @param maxItems The maximum number of items in the view.
+	* @return View on the readable items, empty if there is nothing to be read now.
+	*/
+	std::span<const T> acquireRead(BufferSegmentOwner* pOwner, unsigned long long maxItems) {
+		// Validate owner pointer
+		if (pOwner == nullptr) {
+			throw std::runtime_error("ERR: OWNER NOT FOUND -- nullptr");
+		}
+		if (pOwner->readViewItems != 0) {
+			throw std::runtime_error("ERR: ACQUIRE FAILED -- OWNER HAS AN OUTSTANDING READ VIEW");
+		}
+		if (isSpscReader(pOwner)) {
+			std::span<const T> view = spscAcquireRead(pOwner, maxItems);
+			pOwner->readViewItems = view.size();
+			return view;
+		}
+		if constexpr (!SINGLE_CONSUMER) {
+			if (pOwner->consumerGroup != nullptr) {
+				return claimRead(pOwner, maxItems);
+			}
+			validateAttachedReader(pOwner);
+		}
+		// The buffer segment cannot be freed while it is being looked up and pinned
+		EpochGuard guard;
+		while (true) {
+			BufferSegment<T>* segInRead = currentReadSegment(pOwner);
+			if (segInRead == nullptr) {
+				return std::span<const T>();
+			}
+			// Pin the buffer segment until the view is released, unless it is being dropped
+			if (!(segInRead->tryPin())) {
+				continue;
+			}
+			bool hasNewer{ false };
+			if (ownedSegmentAt(pOwner, pOwner->bufferSegmentReadIndex, hasNewer) != segInRead) {
+				// Dropped (and possibly reused) before it was pinned
+				segInRead->unpin();
+				continue;
+			}
+			unsigned long long readIndex = pOwner->bufferSegmentItemsArrayReadIndex;
+			unsigned long long published = segInRead->writingIndex.load(std::memory_order_acquire);
+			unsigned long long available = std::min(published - readIndex, maxItems);
+			if (available == 0) {
+				segInRead->unpin();
+				return std::span<const T>();
+			}
+			pOwner->readViewItems = available;
+			pOwner->readViewSegment = segInRead;
+			return std::span<const T>((segInRead->items) + readIndex, available);
+		}
+	}
+
+	/**
+	* @brief Releases the view returned by `acquireRead()` and advances the owner's read index by `count` items.
+	*
+	* @param pOwner Pointer to the owner of the buffer segments being read.
+	* @param count The number of items consumed from the view (at most the size of the view).
+	*/
+	void releaseRead(BufferSegmentOwner* pOwner, unsigned long long count) {
+		// Validate owner pointer
+		if (pOwner == nullptr) {
+			throw std::runtime_error("ERR: OWNER NOT FOUND -- nullptr");
+		}
+		if (pOwner->readViewItems == 0) {
+			if (count == 0) {
+				return;		// Nothing was acquired
+			}
+			throw std::runtime_error("ERR: RELEASE FAILED -- NO OUTSTANDING READ VIEW");
+		}
+		if (count > pOwner->readViewItems) {
+			throw std::runtime_error("ERR: RELEASE FAILED -- RELEASED MORE ITEMS THAN ACQUIRED");
+		}
+		if (!(pOwner->readViews.empty())) {
+			throw std::runtime_error("ERR: RELEASE FAILED -- VIEWS ACQUIRED BY acquireReadv() ARE RELEASED BY releaseReadv()");
+		}
+		if (isSpscReader(pOwner)) {
+			// The reader of a pair does not pin the buffer segment, only its cursor is published
+			typename SpscChannel<T>::Consumer& consumer = spscChannelOf(pOwner->partner)->consumer;
+			consumer.readIndex += count;
+			pOwner->bufferSegmentItemsArrayReadIndex.store(consumer.readIndex, std::memory_order_release);
+			pOwner->readViewItems = 0;
+			return;
+		}
+		BufferSegment<T>* segInRead = static_cast<BufferSegment<T>*>(pOwner->readViewSegment);
+		pOwner->bufferSegmentItemsArrayReadIndex += count;
+		pOwner->readViewItems = 0;
+		pOwner->readViewSegment = nullptr;
+		segInRead->unpin();
+	}
+
+	/**
+	* @brief Provides read only views on the items readable by `pOwner` across consecutive buffer segments, without
+	* copying them (e.g. for one vectored write of many buffer segments).
+	*
+	* The first view is the one `acquireRead()` would provide. The next ones follow while the previous buffer segment
+	* was read up to its end and the writer has moved on, each one covering the items published in the next buffer
+	* segment. The buffer segments are pinned until `releaseReadv()` is called. Only one set of views per owner can be
+	* outstanding, and the workers of a consumer group cannot acquire views on more than one buffer segment.
+	*
+	* @param pOwner Pointer to the owner of the buffer segments to be read.
+	* @param views Set to the views, in the order of the buffer (its capacity is reused across calls).
+	* @param maxSegments The maximum number of views.
+	* @param maxItems The maximum number of items in all the views.
+	* @return The number of items in all the views, 0 if there is nothing to be read now.
+	*/
+	unsigned long long acquireReadv(
+		BufferSegmentOwner* pOwner,
+		std::vector<std::span<const T>>& views,
+		unsigned long long maxSegments,
+		unsigned long long maxItems
+	) {
+		views.clear();
+		if (pOwner != nullptr && pOwner->consumerGroup != nullptr) {
+			throw std::runtime_error("ERR: ACQUIRE FAILED -- VIEWS OF A WORKER OF A CONSUMER GROUP ARE ACQUIRED BY acquireRead()");
+		}
+		std::span<const T> first = acquireRead(pOwner, maxItems);
+		if (first.empty() || maxSegments == 0) {
+			// Nothing to be read (an empty view acquired nothing)
+			return first.size();
+		}
+		bool spscReader = isSpscReader(pOwner);
+		BufferSegment<T>* bufferSeg{ nullptr };
+		if (spscReader) {
+			bufferSeg = spscChannelOf(pOwner->partner)->consumer.head;
+		}
+		else {
+			bufferSeg = static_cast<BufferSegment<T>*>(pOwner->readViewSegment);
+			pOwner->readViewSegment = nullptr;		// The pin goes with the views
+		}
+		views.push_back(first);
+		pOwner->readViews.emplace_back(bufferSeg, first.size());
+		unsigned long long total = first.size();
+		unsigned long long end = static_cast<unsigned long long>(first.data() + first.size() - bufferSeg->items);
+		unsigned long long segmentIndex = pOwner->bufferSegmentReadIndex;
+		// The buffer segments cannot be freed while they are being looked up and pinned
+		EpochGuard guard;
+		while (views.size() < maxSegments && total < maxItems) {
+			// The last items of a buffer segment are published before the next one is linked
+			BufferSegment<T>* next = bufferSeg->nextInChain.load(std::memory_order_acquire);
+			if (next == nullptr || end < bufferSeg->writingIndex.load(std::memory_order_acquire)) {
+				break;
+			}
+			if (!spscReader) {
+				if (!(next->tryPin())) {
+					break;
+				}
+				bool hasNewer{ false };
+				if (ownedSegmentAt(pOwner, segmentIndex + 1, hasNewer) != next) {
+					// Dropped (and possibly reused) before it was pinned
+					next->unpin();
+					break;
+				}
+			}
+			unsigned long long available = std::min(next->writingIndex.load(std::memory_order_acquire), maxItems - total);
+			if (available == 0) {
+				if (!spscReader) {
+					next->unpin();
+				}
+				break;
+			}
+			noteReached(next);
+			views.emplace_back(next->items, available);
+			pOwner->readViews.emplace_back(next, available);
+			total += available;
+			bufferSeg = next;
+			end = available;
+			++segmentIndex;
+		}
+		pOwner->readViewItems = total;
+		return total;
+	}
+
+	/**
+	* @brief Releases the views returned by `acquireReadv()` and advances the owner's read index by `count` items,
+	* across the buffer segments of the views.
+	*
+	* @param pOwner Pointer to the owner of the buffer segments being read.
+	* @param count The number of items consumed from the views (at most the number of items in them).
+	*/
+	void releaseReadv(BufferSegmentOwner* pOwner, unsigned long long count) {
+		if (pOwner == nullptr) {
+			throw std::runtime_error("ERR: OWNER NOT FOUND -- nullptr");
+		}
+		if (pOwner->readViews.empty()) {
+			if (count == 0) {
+				return;		// Nothing was acquired
+			}
+			throw std::runtime_error("ERR: RELEASE FAILED -- NO OUTSTANDING READ VIEW");
+		}
+		if (count > pOwner->readViewItems) {
+			throw std::runtime_error("ERR: RELEASE FAILED -- RELEASED MORE ITEMS THAN ACQUIRED");
+		}
+		bool spscReader = isSpscReader(pOwner);
+		std::vector<std::pair<void*, unsigned long long>>& views = pOwner->readViews;
+		unsigned long long remaining = count;
+		for (unsigned long long i = 0; i < views.size(); ++i) {
+			unsigned long long consumed = std::min(remaining, views[i].second);
+			remaining -= consumed;
+			// A buffer segment read up to the end of its view has been read completely if a newer view follows it
+			bool movesOn = consumed == views[i].second && (i + 1) < views.size();
+			if (spscReader) {
+				typename SpscChannel<T>::Consumer& consumer = spscChannelOf(pOwner->partner)->consumer;
+				consumer.readIndex += consumed;
+				if (movesOn) {
+					// Hand the head back to the writer (see `spscAcquireRead()`)
+					BufferSegment<T>* next = static_cast<BufferSegment<T>*>(views[i + 1].first);
+					while (!(consumer.head->tryDrop())) {
+						std::this_thread::yield();
+					}
+					recycleBufferSegment(consumer.head);
+					consumer.head = next;
+					consumer.readIndex = 0;
+					consumer.published = next->writingIndex.load(std::memory_order_acquire);
+					++(pOwner->bufferSegmentReadIndex);
+				}
+				pOwner->bufferSegmentItemsArrayReadIndex.store(consumer.readIndex, std::memory_order_release);
+				continue;
+			}
+			pOwner->bufferSegmentItemsArrayReadIndex += consumed;
+			if (movesOn) {
+				++(pOwner->bufferSegmentReadIndex);
+				pOwner->bufferSegmentItemsArrayReadIndex = 0ULL;
+			}
+		}
+		if (!spscReader) {
+			for (std::pair<void*, unsigned long long>& view : views) {
+				static_cast<BufferSegment<T>*>(view.first)->unpin();
+			}
+		}
+		views.clear();
+		pOwner->readViewItems = 0;
+	}
+
+	/**
+	* @brief Waits at most `timeout` until `pOwner` has an item to read (see `readBlocking()`), without reading it.
+	*
+	* @param pOwner Pointer to the owner of the buffer segments to be read.
+	* @param timeout The maximum time to wait.
+	* @return false if nothing was published in time.
+	*/
+	template <typename Rep, typename Period>
+	bool waitForItems(BufferSegmentOwner* pOwner, const std::chrono::duration<Rep, Period>& timeout) {
+		if (pOwner == nullptr) {
+			throw std::runtime_error("ERR: OWNER NOT FOUND -- nullptr");
+		}
+		return waitForData(pOwner, std::chrono::steady_clock::now() +
+			std::chrono::ceil<std::chrono::steady_clock::duration>(timeout));
+	}
+
+	/**
+	* @brief Reads all items of a buffer segment.
+	*
+	* Returns all items of the buffer segment at `bufferSegmentIndex` in the buffer, which must be owned by `pOwner`.
+	* The buffer segment is found in constant time regardless of the number of buffer segments in the buffer. Use
+	* while loop over `bufferSegmentIndex` to get the next buffer segment's items.
+	*
+	* @param pOwner Pointer to the owner of the buffer segments to be read.
+	* @param bufferSegmentIndex The index of the buffer segment in the buffer.
+	* @param count Set to the number of items readable in the buffer segment (its published `writingIndex`).
+	*
+	* @return Pointer to the `items` array of the buffer segment. It stays valid as long as the buffer segment is not
+	* consumed by all of its owners (the pruner recycles it then).
+	*/
+	const T* read(BufferSegmentOwner* pOwner, unsigned long long bufferSegmentIndex, unsigned long long& count) {
+		/*
+		* Unrestricted read except when the buffer segment is being written to. Thus there is no use of owner's
+		* thread mutex here.
+		*/
+		// Validate owner pointer
+		if (pOwner == nullptr) {
+			throw std::runtime_error("ERR: OWNER NOT FOUND -- nullptr");
+		}
+		EpochGuard guard;
+		BufferSegment<T>* bufferSeg = bufferSegments.at(bufferSegmentIndex);
+		if (bufferSeg == nullptr) {
+			throw std::runtime_error("NO ITEM FOUND -- END REACHED");
+		}
+		if (!(bufferSeg->doesOwnerExist(pOwner))) {
+			throw std::runtime_error("ERR: NO BUFFER ENTRY FOR OWNER : " + std::to_string((unsigned long long)((void*)pOwner)));
+		}
+		count = bufferSeg->writingIndex.load(std::memory_order_acquire);
+		return bufferSeg->items;
+	}
+
+	/**
+	* @brief Provides direct hook to the buffer segment's dynamic array for use with networking like Bluetooth,
+	* TCP/IP etc. Generally used in `recv` and `read` functions to receive data straight into the buffer.
+	*
+	* Reserves `count` contiguous items at the end of the last buffer segment owned by `pOwner`. If that buffer segment
+	* cannot hold `count` more items, a new buffer segment (of at least `count` items) is created and owned by
+	* `pOwner`. The reserved items are not readable until they are published by `commit()`.
+	*
+	* Only one reservation per owner can be outstanding. Writes of the owner are rejected until it is committed.
+	*
+	* WARNING: A VIEW ON THE BUFFER SEGMENT'S (WHOSE OWNER IS `pOwner`) DYNAMIC ARRAY WHICH HOUSES THE ACTUAL
+	* DATA IS SENT TO THE CALLER. IT IS VALID ONLY UNTIL `commit()` IS CALLED.
+	*
+	* @param pOwner Pointer to the owner with write access
+	* @param count The number of items to be reserved.
+	* @return Writable view on `count` items of the buffer segment, empty if the memory budget is exhausted and the
+	* overflow policy drops the items.
+	*/
+	std::span<T> reserve(BufferSegmentOwner* pOwner, unsigned long long count) {
+		validateWriter(pOwner);
+		// Keep the order with the items already queued on the owner's writer worker
+		pOwner->flushWriterWorker();
+		AppendLock appendLock(pOwner->appendMutex);
+		if (pOwner->reservedItems != 0) {
+			throw std::runtime_error("ERR: RESERVE FAILED -- OWNER HAS AN OUTSTANDING RESERVATION");
+		}
+		BufferSegment<T>* lastSeg = lastOwnedSegment(pOwner);
+		if (
+			lastSeg == nullptr || !(lastSeg->isWritable()) ||
+			(capacityOf(lastSeg) - (lastSeg->writingIndex)) < count
+			) {
+			// Create a buffer segment which can hold the whole reservation
+			lastSeg = createBufferSegment(
+				std::max(count, nextSegmentSize(pOwner, lastSeg)),
+				pOwner
+			);
+			if (lastSeg == nullptr) {
+				// Over the memory budget, nothing can be reserved (the items would be dropped)
+				return std::span<T>();
+			}
+		}
+		// Block the writes on this buffer segment until the reservation is committed
+		lastSeg->inWrite = true;
+		pOwner->reservedItems = count;
+		T* reserved = (lastSeg->items) + (lastSeg->writingIndex);
+		if constexpr (!std::is_trivially_copyable_v<T>) {
+			// The caller assigns to the reserved items, so they have to be alive
+			std::uninitialized_value_construct_n(reserved, count);
+		}
+		return std::span<T>(reserved, count);
+	}
+
+	/**
+	* @brief Reserves the room left at the end of the last buffer segment owned by `pOwner`, at most `maxCount` items,
+	* without creating a buffer segment (see `reserve()`).
+	*
+	* Used with `reserveSegment()` to receive into the rest of the last buffer segment and a new one with a single
+	* scattered read. The reservation is published by `commit()`.
+	*
+	* @param pOwner Pointer to the owner with write access
+	* @param maxCount The maximum number of items to be reserved.
+	* @return Writable view on the reserved items, empty (and nothing is reserved) if the last buffer segment is full.
+	*/
+	std::span<T> reserveAvailable(BufferSegmentOwner* pOwner, unsigned long long maxCount) requires std::is_trivially_copyable_v<T> {
+		validateWriter(pOwner);
+		// Keep the order with the items already queued on the owner's writer worker
+		pOwner->flushWriterWorker();
+		AppendLock appendLock(pOwner->appendMutex);
+		if (pOwner->reservedItems != 0) {
+			throw std::runtime_error("ERR: RESERVE FAILED -- OWNER HAS AN OUTSTANDING RESERVATION");
+		}
+		BufferSegment<T>* lastSeg = lastOwnedSegment(pOwner);
+		if (lastSeg == nullptr || !(lastSeg->isWritable())) {
+			return std::span<T>();
+		}
+		unsigned long long count = std::min(maxCount, capacityOf(lastSeg) - (lastSeg->writingIndex));
+		if (count == 0) {
+			return std::span<T>();
+		}
+		// Block the writes on this buffer segment until the reservation is committed
+		lastSeg->inWrite = true;
+		pOwner->reservedItems = count;
+		return std::span<T>((lastSeg->items) + (lastSeg->writingIndex), count);
+	}
+
+	/**
+	* @brief Publishes `count` items of the outstanding reservation of `pOwner` to the readers.
+	*
+	* `count` may be less than the number of items reserved (e.g. when `recv` returned less data), the rest of the
+	* reservation is given back. A `count` of zero(0) cancels the reservation (or acknowledges an empty view returned by
+	* `reserve()` when the memory budget is exhausted).
+	*
+	* @param pOwner Pointer to the owner with write access
+	* @param count The number of items written to the view returned by `reserve()`.
+	*/
+	void commit(BufferSegmentOwner* pOwner, unsigned long long count) {
+		validateWriter(pOwner);
+		AppendLock appendLock(pOwner->appendMutex);
+		if (pOwner->reservedItems == 0) {
+			if (count == 0) {
+				return;		// Nothing was reserved
+			}
+			throw std::runtime_error("ERR: COMMIT FAILED -- NO OUTSTANDING RESERVATION");
+		}
+		if (count > pOwner->reservedItems) {
+			throw std::runtime_error("ERR: COMMIT FAILED -- COMMITTED MORE ITEMS THAN RESERVED");
+		}
+		// No other append is allowed while reserved, hence the last buffer segment is the reserved one
+		BufferSegment<T>* lastSeg = lastOwnedSegment(pOwner);
+		if constexpr (!std::is_trivially_copyable_v<T>) {
+			// The items given back are not published, they are destroyed here
+			std::destroy_n((lastSeg->items) + (lastSeg->writingIndex) + count, (pOwner->reservedItems) - count);
+		}
+		lastSeg->writingIndex.fetch_add(count, std::memory_order_release);
+		lastSeg->inWrite = false;
+		pOwner->reservedItems = 0;
+		wakeParkedReaders(lastSeg);
+		syncSpscProducer(pOwner);
+	}
+
+	/**
+	* @brief Provides a whole buffer segment of at least `count` items to be filled outside the buffer, e.g. by an
+	* asynchronous read which completes later.
+	*
+	* Unlike `reserve()`, the buffer segment is not appended to the buffer yet and any number of them can be outstanding
+	* for an owner. Each one is appended by `commitSegment()` (in the order of the calls, whatever the order the buffer
+	* segments were filled in) or given back by `cancelSegment()`, before the buffer is destroyed.
+	*
+	* @param count The number of items the buffer segment must hold.
+	* @return Pointer to the buffer segment, whose `items` can be written up to `size`, or nullptr if the memory budget
+	* is exhausted and the overflow policy drops the items.
+	*/
+	BufferSegment<T>* reserveSegment(unsigned long long count) requires std::is_trivially_copyable_v<T> {
+		if (count == 0) {
+			throw std::runtime_error("ERR: RESERVE FAILED -- 0 ITEMS");
+		}
+		return allocateBufferSegment(count);
+	}
+
+	/**
+	* @brief Provides a whole buffer segment of at least `count` items like `reserveSegment()`, without ever waiting
+	* for memory or applying the overflow policy.
+	*
+	* For a caller which holds buffer segments it has not committed yet: blocking on the memory budget would wait for
+	* memory only its own commits can free.
+	*
+	* @param count The number of items the buffer segment must hold.
+	* @return Pointer to the buffer segment or nullptr if the memory budget is exhausted.
+	*/
+	BufferSegment<T>* tryReserveSegment(unsigned long long count) requires std::is_trivially_copyable_v<T> {
+		if (count == 0) {
+			throw std::runtime_error("ERR: RESERVE FAILED -- 0 ITEMS");
+		}
+		return allocateBufferSegment(count, false);
+	}
+
+	/**
+	* @brief Appends a buffer segment provided by `reserveSegment()` to the buffer segments owned by `*pOwner` and
+	* publishes its first `count` items.
+	*
+	* The next write of the owner starts a new buffer segment. A `count` of zero(0) gives the buffer segment back.
+	*
+	* @param pOwner Pointer to the owner with write access
+	* @param bufferSeg Pointer to the buffer segment
+	* @param count The number of items written to the buffer segment.
+	*/
+	void commitSegment(
+		BufferSegmentOwner* pOwner,
+		BufferSegment<T>* bufferSeg,
+		unsigned long long count
+	) requires std::is_trivially_copyable_v<T> {
+		validateWriter(pOwner);
+		if (count > bufferSeg->size) {
+			throw std::runtime_error("ERR: COMMIT FAILED -- COMMITTED MORE ITEMS THAN RESERVED");
+		}
+		if (count == 0) {
+			cancelSegment(bufferSeg);
+			return;
+		}
+		// Keep the order with the items already queued on the owner's writer worker
+		pOwner->flushWriterWorker();
+		{
+			AppendLock appendLock(pOwner->appendMutex);
+			if (pOwner->reservedItems != 0) {
+				throw std::runtime_error("ERR: COMMIT FAILED -- OWNER HAS AN OUTSTANDING RESERVATION");
+			}
+			// Published before it is linked, the readers see the items as soon as they see the buffer segment
+			bufferSeg->writingIndex.store(count, std::memory_order_release);
+			linkBufferSegment(bufferSeg, pOwner);
+		}
+		syncSpscProducer(pOwner);
+	}
+
+	/**
+	* @brief Gives back a buffer segment provided by `reserveSegment()` without appending it to the buffer.
+	*
+	* @param bufferSeg Pointer to the buffer segment
+	*/
+	void cancelSegment(BufferSegment<T>* bufferSeg) requires std::is_trivially_copyable_v<T> {
+		if (segmentPool.give(bufferSeg)) {
+			notifyMemoryReleased();
+		}
+		else {
+			freeBufferSegment(bufferSeg);
+		}
+	}
+
+	/**
+	* @brief Writes a variable-length record to a byte stream (`DynBuffer<std::byte>`).
+	*
+	* The record is framed by its length (`RECORD_HEADER_SIZE` bytes, native byte order) and packed right after the
+	* previous record of the owner, with its payload aligned to `RECORD_ALIGNMENT` bytes. A record never spans two
+	* buffer segments: when it does not fit in the rest of the last buffer segment of the owner, a new buffer segment
+	* (large enough for the record) is created. The record is published as a whole.
+	*
+	* Records and plain items (`write()`, `reserve()`) must not be mixed in the stream of one owner.
+	*
+	* @param record The payload of the record, must not be empty.
+	* @param pOwner Pointer to the owner with write access
+	* @return false if the record was dropped since the memory budget is exhausted (see `setMemoryBudget()`).
+	*/
+	bool writeRecord(std::span<const std::byte> record, BufferSegmentOwner* pOwner) requires std::is_same_v<T, std::byte> {
+		validateWriter(pOwner);
+		if (record.empty()) {
+			throw std::runtime_error("ERR: WRITE OP FAILED -- EMPTY RECORD");
+		}
+		// Keep the order with the items already queued on the owner's writer worker
+		pOwner->flushWriterWorker();
+		AppendLock appendLock(pOwner->appendMutex);
+		if (pOwner->reservedItems != 0) {
+			throw std::runtime_error("ERR: WRITE OP FAILED -- OWNER HAS AN OUTSTANDING RESERVATION");
+		}
+		BufferSegment<T>* lastSeg = lastOwnedSegment(pOwner);
+		unsigned long long headerIndex{ 0 };
+		if (lastSeg != nullptr) {
+			headerIndex = (lastSeg->writingIndex) + recordPadding((lastSeg->items) + (lastSeg->writingIndex));
+		}
+		if (
+			lastSeg == nullptr || !(lastSeg->isWritable()) ||
+			headerIndex + RECORD_HEADER_SIZE + record.size() > capacityOf(lastSeg)
+			) {
+			// Roll over to a new buffer segment, the payload starts at `RECORD_ALIGNMENT` in it
+			lastSeg = createBufferSegment(
+				std::max(RECORD_ALIGNMENT + record.size(), nextSegmentSize(pOwner, lastSeg)),
+				pOwner
+			);
+			if (lastSeg == nullptr) {
+				// Over the memory budget, the record is dropped
+				droppedItems.fetch_add(record.size(), std::memory_order_relaxed);
+				return false;
+			}
+			headerIndex = recordPadding(lastSeg->items);
+		}
+		{
+			AppendLock lock(lastSeg->writerMutex);
+			std::uint64_t length = record.size();
+			std::byte* header = (lastSeg->items) + headerIndex;
+			std::memcpy(header, &length, RECORD_HEADER_SIZE);
+			std::memcpy(header + RECORD_HEADER_SIZE, record.data(), record.size());
+			// publish the whole record
+			lastSeg->writingIndex.store(headerIndex + RECORD_HEADER_SIZE + record.size(), std::memory_order_release);
+		}
+		wakeParkedReaders(lastSeg);
+		syncSpscProducer(pOwner);
+		return true;
+	}
+
+	/**
+	* @brief Reads the next record of a byte stream (`DynBuffer<std::byte>`) written by `writeRecord()`, without
+	* copying it.
+	*
+	* The payload is aligned to `RECORD_ALIGNMENT` bytes. The view is valid until `releaseRecord()` is called, which
+	* must be done before the owner reads again (see `acquireRead()`).
+	*
+	* @param pOwner Pointer to the owner of the buffer segments to be read (not a worker of a consumer group).
+	* @return View on the payload of the record, empty if no record is available now.
+	*/
+	std::span<const std::byte> readRecord(BufferSegmentOwner* pOwner) requires std::is_same_v<T, std::byte> {
+		if (pOwner != nullptr && pOwner->consumerGroup != nullptr) {
+			// A claim could split a record
+			throw std::runtime_error("ERR: READ OP FAILED -- RECORDS ARE NOT READ THROUGH CONSUMER GROUPS");
+		}
+		std::span<const std::byte> view = acquireRead(pOwner, ~0ULL);
+		if (view.empty()) {
+			return view;
+		}
+		// The records are published as a whole, hence the view covers the next record completely
+		unsigned long long headerIndex = recordPadding(view.data());
+		std::uint64_t length{ 0 };
+		if (view.size() >= headerIndex + RECORD_HEADER_SIZE) {
+			std::memcpy(&length, view.data() + headerIndex, RECORD_HEADER_SIZE);
+		}
+		if (length == 0 || view.size() - headerIndex - RECORD_HEADER_SIZE < length) {
+			releaseRead(pOwner, 0);
+			throw std::runtime_error("ERR: READ OP FAILED -- CORRUPTED RECORD");
+		}
+		// The view is shrunk to the record, releasing it consumes the record
+		pOwner->readViewItems = headerIndex + RECORD_HEADER_SIZE + length;
+		return view.subspan(headerIndex + RECORD_HEADER_SIZE, length);
+	}
+
+	/**
+	* @brief Consumes the record returned by `readRecord()` and releases its view.
+	*
+	* @param pOwner Pointer to the owner of the buffer segments being read.
+	*/
+	void releaseRecord(BufferSegmentOwner* pOwner) requires std::is_same_v<T, std::byte> {
+		if (pOwner == nullptr) {
+			throw std::runtime_error("ERR: OWNER NOT FOUND -- nullptr");
+		}
+		releaseRead(pOwner, pOwner->readViewItems);
+	}
+
+private:
+
+	// Compile-time policy of the buffer (see `BufferPolicy`)
+	static constexpr bool SINGLE_PRODUCER = Policy::concurrency == BUFFER_CONCURRENCY::SPSC;
+	static constexpr bool SINGLE_CONSUMER = Policy::concurrency != BUFFER_CONCURRENCY::MPMC;
+	static constexpr ull FIXED_CAPACITY = Policy::segmentCapacity;		// 0 : adaptive sizing
+	// The lock serializing the appends to a writer's buffer segments, not needed when a writer has a single thread
+	using AppendLock = std::conditional_t<SINGLE_PRODUCER, ElidedLock, std::lock_guard<std::mutex>>;
+
+	static constexpr ull MIN_READ_SPINS = 16ULL;		// Bounds of the polls of a blocking read before it parks
+	static constexpr ull MAX_READ_SPINS = 1ULL << 14;
+
+	// Framing of the records of a byte stream (see `writeRecord()`)
+	static constexpr ull RECORD_HEADER_SIZE = sizeof(std::uint64_t);	// The length prefix of a record
+	static constexpr ull RECORD_ALIGNMENT = 16ULL;						// The alignment of the payload of a record
+
+	SegmentSizingPolicy sizingPolicy{};					// Bounds of the adaptive sizing of new buffer segments
+	ull writerQueueCapacity = 4096ULL;					// The number of items an owner's writer worker can hold
+	// before `write()` blocks
+	std::list<BufferSegmentOwner*> writerOwners;		// Owners whose writer workers were started by this buffer
+	std::mutex writerOwnersMutex;						// A mutex for using lock on `writerOwners`
+
+	// Pruner thread related members
+	std::atomic<ull> intervalMS{ 2000ULL };				// This variable holds the time interval in milliseconds
+	// (default : 2000ms) after which prunning is performed.
+	ull pruneSlotsPerPass = 1024ULL;					// The number of directory slots looked over by one prunning
+	// pass (the "region" of the pass)
+	std::thread prunerThreadEngine;						// The pruner thread engine which runs the prunning passes
+	std::mutex prunerMutex;								// A mutex for waiting on `prunerWakeup`
+	std::condition_variable prunerWakeup;				// Notified to stop the pruner or to request a pass
+	bool pruneRequested{ false };						// Whether a pass was requested (guarded by `prunerMutex`)
+	bool prunerStopping{ false };						// Whether the pruner is to stop (guarded by `prunerMutex`)
+	std::mutex pruneMutex;								// Held by the running prunning pass
+	ull pruneCursor{ 0 };								// The directory slot the next pass starts at (guarded by
+	// `pruneMutex`)
+
+	static constexpr unsigned CLAIM_OFFSET_BITS = 32;		// The bits of the item index in a claim cursor
+	static constexpr ull CLAIM_OFFSET_MASK = (1ULL << CLAIM_OFFSET_BITS) - 1;
+	std::list<BufferSegmentOwner*> attachedReaders;		// The readers attached by `attachReader()`, owned by the buffer
+	std::mutex attachedReadersMutex;					// A mutex for `attachedReaders`
+
+	std::atomic<ull> memoryBudget{ ~0ULL };				// The memory budget in bytes (default : unlimited)
+	std::atomic<BUFFER_OVERFLOW_POLICY> overflowPolicy{ BUFFER_OVERFLOW_POLICY::BLOCK };
+	std::atomic<ull> memoryInUse{ 0 };					// The bytes held by the buffer segments of this buffer
+	std::atomic<ull> droppedItems{ 0 };					// The items dropped by the overflow policies
+	std::atomic<ull> memoryGeneration{ 0 };				// Bumped every time memory may have become available
+	std::atomic<int> blockedWriters{ 0 };				// The writers waiting on `memoryReleased`
+	std::mutex memoryMutex;								// A mutex for waiting on `memoryReleased`
+	std::condition_variable memoryReleased;				// Notified when a buffer segment is drained or freed
+	std::atomic<ull> oldestSegmentHint{ 0 };			// No buffer segment before this directory index is left
+
+	SegmentDirectory<T> bufferSegments;				// The buffer segments of this buffer in the order of creation
+	SegmentPool<T> segmentPool{							// Drained buffer segments kept for reuse
+		[this](BufferSegment<T>* bufferSeg) { freeBufferSegment(bufferSeg); }
+	};
+	EpochLimbo limbo;									// Buffer segments and directory chunks waiting to be freed
+
+	std::unordered_map<ull, std::unique_ptr<OwnedSegmentIndex<T>>>
+		ownedSegments;									// Index of the buffer segments owned by every owner (by UID) in
+	// the order of the buffer
+	std::mutex ownedSegmentsMutex;						// A mutex for using lock on `ownedSegments` (taken only when an
+	// owner's index is created)
+
+	/**
+	* @brief Get the writer worker of the owner, starting it on the first call.
+	*
+	* @param pOwner Pointer to the owner with write access
+	* @return The writer worker which writes the owner's submissions into this buffer.
+	*/
+	SegmentWriterWorker<T>* writerWorkerOf(BufferSegmentOwner* pOwner) {
+		OwnerWorker* pWorker = pOwner->writerWorker.load(std::memory_order_acquire);
+		if (pWorker == nullptr) {
+			std::lock_guard<std::mutex> lock(pOwner->writerWorkerMutex);
+			pWorker = pOwner->writerWorker.load(std::memory_order_relaxed);
+			if (pWorker == nullptr) {
+				pWorker = new SegmentWriterWorker<T>(
+					writerQueueCapacity,
+					[this, pOwner](T* items, unsigned long long count) {
+						// The batch is the worker's own, its items are moved
+						appendItems(items, count, pOwner);
+					}
+				);
+				{
+					std::lock_guard<std::mutex> ownersLock(writerOwnersMutex);
+					writerOwners.push_back(pOwner);
+				}
+				pOwner->writerWorker.store(pWorker, std::memory_order_release);
+			}
+		}
+		// An owner is used in only one buffer, hence its worker is always of this buffer's type
+		return static_cast<SegmentWriterWorker<T>*>(pWorker);
+	}
+
+	/**
+	* @brief Checks whether `pOwner` is the reader of a reader-writer pair, which reads through the lock-free
+	* single-producer/single-consumer protocol.
+	*/
+	bool isSpscReader(BufferSegmentOwner* pOwner) const {
+		return pOwner->isPartOfReaderWriterPair && pOwner->partner != nullptr &&
+			pOwner->getAccessLevel() != BUFFER_SEGMENT_ACCESS_LEVEL::WRITE;
+	}
+
+	/**
+	* @brief Get the single-producer/single-consumer channel of the writer of a pair, creating it on the first call.
+	*
+	* @param pWriter Pointer to the writer of the reader-writer pair
+	* @return The channel, stored as the writer's worker.
+	*/
+	SpscChannel<T>* spscChannelOf(BufferSegmentOwner* pWriter) {
+		OwnerWorker* pWorker = pWriter->writerWorker.load(std::memory_order_acquire);
+		if (pWorker == nullptr) {
+			std::lock_guard<std::mutex> lock(pWriter->writerWorkerMutex);
+			pWorker = pWriter->writerWorker.load(std::memory_order_relaxed);
+			if (pWorker == nullptr) {
+				pWorker = new SpscChannel<T>();
+				{
+					std::lock_guard<std::mutex> ownersLock(writerOwnersMutex);
+					writerOwners.push_back(pWriter);
+				}
+				pWriter->writerWorker.store(pWorker, std::memory_order_release);
+			}
+		}
+		// Only the writer of a pair has a channel as its worker
+		return static_cast<SpscChannel<T>*>(pWorker);
+	}
+
+	/**
+	* @brief Constructs a single item of the writer of a pair in its buffer segment and publishes it with release
+	* semantics.
+	*
+	* @param pWriter Pointer to the writer of the reader-writer pair
+	* @param args The arguments of the constructor of `T`.
+	*/
+	template <typename... Args> void spscEmplace(BufferSegmentOwner* pWriter, Args&&... args) {
+		typename SpscChannel<T>::Producer& producer = spscChannelOf(pWriter)->producer;
+		if (pWriter->reservedItems != 0) {
+			throw std::runtime_error("ERR: WRITE OP FAILED -- OWNER HAS AN OUTSTANDING RESERVATION");
+		}
+		if (producer.tail == nullptr) {
+			// The first write of the writer, continue in the buffer segment `use()` created for it
+			syncSpscProducer(pWriter);
+		}
+		if (producer.tail == nullptr || producer.writingIndex == producer.size) {
+			// The tail is full, continue in a new buffer segment (linked to the chain)
+			BufferSegment<T>* next = createBufferSegment(
+				nextSegmentSize(pWriter, producer.tail),
+				pWriter
+			);
+			if (next == nullptr) {
+				// Over the memory budget, the item is dropped
+				droppedItems.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+			producer.tail = next;
+			producer.writingIndex = 0;
+			producer.size = capacityOf(producer.tail);
+		}
+		std::construct_at((producer.tail->items) + producer.writingIndex, std::forward<Args>(args)...);
+		++(producer.writingIndex);
+		producer.tail->writingIndex.store(producer.writingIndex, std::memory_order_release);
+		wakeParkedReaders(producer.tail);
+	}
+
+	/**
+	* @brief Re-reads the writer's cached tail after the writer of a pair appended through the locked paths (bulk
+	* `write()`, `commit()`).
+	*
+	* @param pOwner Pointer to the owner with write access
+	*/
+	void syncSpscProducer(BufferSegmentOwner* pOwner) {
+		if (!SINGLE_PRODUCER && !(pOwner->isPartOfReaderWriterPair)) {
+			return;
+		}
+		typename SpscChannel<T>::Producer& producer = spscChannelOf(pOwner)->producer;
+		producer.tail = lastOwnedSegment(pOwner);
+		if (producer.tail != nullptr) {
+			producer.writingIndex = producer.tail->writingIndex.load(std::memory_order_relaxed);
+			producer.size = capacityOf(producer.tail);
+		}
+	}
+
+	/**
+	* @brief Provides the view of the reader of a pair on its head buffer segment.
+	*
+	* The shared `writingIndex` is loaded only when the reader has consumed everything it saw published before. When
+	* the head buffer segment is exhausted and the writer has linked a newer one, the reader moves to it.
+	*
+	* @param pReader Pointer to the reader of the reader-writer pair
+	* @param maxItems The maximum number of items in the view.
+	* @return View on the readable items, empty if there is nothing to be read now.
+	*/
+	std::span<const T> spscAcquireRead(BufferSegmentOwner* pReader, unsigned long long maxItems) {
+		if (pReader->partner->writerWorker.load(std::memory_order_acquire) == nullptr) {
+			return std::span<const T>();	// The writer has not written anything yet
+		}
+		typename SpscChannel<T>::Consumer& consumer = spscChannelOf(pReader->partner)->consumer;
+		if (consumer.head == nullptr) {
+			bool hasNewer{ false };
+			consumer.head = ownedSegmentAt(pReader->partner, 0, hasNewer);
+			if (consumer.head == nullptr) {
+				return std::span<const T>();
+			}
+			noteReached(consumer.head);
+		}
+		if (consumer.readIndex == consumer.published) {
+			consumer.published = consumer.head->writingIndex.load(std::memory_order_acquire);
+			while (consumer.readIndex == consumer.published) {
+				BufferSegment<T>* next = consumer.head->nextInChain.load(std::memory_order_acquire);
+				if (next == nullptr) {
+					return std::span<const T>();
+				}
+				// The last items of the head are published before the next buffer segment is linked
+				consumer.published = consumer.head->writingIndex.load(std::memory_order_acquire);
+				if (consumer.readIndex != consumer.published) {
+					break;
+				}
+				// The head has been read completely by the only reader of the pair, hand it back to the writer (once the
+				// pruner, which may be looking at it, lets go of it)
+				while (!(consumer.head->tryDrop())) {
+					std::this_thread::yield();
+				}
+				recycleBufferSegment(consumer.head);
+				consumer.head = next;
+				consumer.readIndex = 0;
+				consumer.published = next->writingIndex.load(std::memory_order_acquire);
+				noteReached(next);
+				++(pReader->bufferSegmentReadIndex);
+				pReader->bufferSegmentItemsArrayReadIndex.store(0ULL, std::memory_order_release);
+			}
+		}
+		unsigned long long available = std::min(consumer.published - consumer.readIndex, maxItems);
+		return std::span<const T>((consumer.head->items) + consumer.readIndex, available);
+	}
+
+	/**
+	* @brief Wakes the readers parked on a buffer segment (or on an owner's index) after the writer published to it.
+	*
+	* The publication is ordered before the check of `parkedReaders` by an asymmetric fence whose expensive side is paid
+	* by the parking reader, which registers itself before it checks for new items. So either the writer sees the reader
+	* or the reader sees the items, at the cost of a compiler barrier per publication.
+	*
+	* @param pParkable Pointer to the buffer segment or the owner's index
+	*/
+	template <typename Parkable> void wakeParkedReaders(Parkable* pParkable) {
+		asymmetricLightFence();
+		if (pParkable->parkedReaders.load(std::memory_order_relaxed) != 0) {
+			wakeAllParked(pParkable);
+		}
+	}
+
+	/**
+	* @brief Bumps the parking word of a buffer segment (or of an owner's index).
+	*/
+	void wakeAllParked(BufferSegment<T>* bufferSeg) {
+		bufferSeg->publications.wakeAll();
+	}
+
+	void wakeAllParked(OwnedSegmentIndex<T>* pIndex) {
+		pIndex->appended.wakeAll();
+	}
+
+	/**
+	* @brief Waits until `pOwner` has an item to read or the `deadline` has passed.
+	*
+	* Polls `readSpins` times first and parks afterwards (see `parkReader()`). The number of polls doubles when an item
+	* arrived while polling and halves when the owner had to park.
+	*
+	* @return false if the deadline has passed without an item to read.
 	*/
-	std::atomic<bool> inRead{ false };
+	bool waitForData(BufferSegmentOwner* pOwner, const std::optional<std::chrono::steady_clock::time_point>& deadline) {
+		for (unsigned long long spin = 0; spin < pOwner->readSpins; ++spin) {
+			if (hasNext(pOwner)) {
+				pOwner->readSpins = std::min(MAX_READ_SPINS, (pOwner->readSpins) * 2);
+				return true;
+			}
+			cpuRelax();
+		}
+		pOwner->readSpins = std::max(MIN_READ_SPINS, (pOwner->readSpins) / 2);
+		while (!hasNext(pOwner)) {
+			if (!parkReader(pOwner, deadline)) {
+				return hasNext(pOwner);
+			}
+		}
+		return true;
+	}
 
 	/**
-	* @brief Destructor
+	* @brief Parks `pOwner` once, on the buffer segment it reads, until the writer publishes to it or links the next
+	* buffer segment. An owner without a buffer segment to read parks on its index until one is added.
 	*
-	* Calls to the destructor destroys the buffer items contained within this `BufferSegment` after and before
-	* performing necessary cleanup.
+	* The buffer segment is pinned while the owner is parked (a parked owner must not hold up the epochs).
+	*
+	* @return false if the deadline has passed.
 	*/
-	~BufferSegment() {
-		// wait for owners to finish their task on this buffer segment
-		for (typename std::list<BufferSegmentOwner*>::iterator it = owners->begin(); it != (owners->end());) {
-			BufferSegmentOwner* pOwner = *it;
-			// Check if reference count of the owner instnace will drop to 0 after deletion
-			if (pOwner->getRefCount() == 1) {
-				// delete this owner
-				delete* it;
-				*it = nullptr;
+	bool parkReader(BufferSegmentOwner* pOwner, const std::optional<std::chrono::steady_clock::time_point>& deadline) {
+		BufferSegment<T>* target{ nullptr };
+		BufferSegment<T>* pinned{ nullptr };
+		unsigned long long readIndex{ 0 };
+		unsigned long long segmentIndex = pOwner->bufferSegmentReadIndex;
+		{
+			EpochGuard guard;
+			if (isSpscReader(pOwner)) {
+				// The head of the reader of a pair is only ever recycled by the reader itself
+				if (pOwner->partner->writerWorker.load(std::memory_order_acquire) != nullptr) {
+					typename SpscChannel<T>::Consumer& consumer = spscChannelOf(pOwner->partner)->consumer;
+					target = consumer.head;
+					readIndex = consumer.readIndex;
+				}
 			}
 			else {
-				// The owner must not be deleted here
-				// Wait for owner's Thread to finish its execution (if there are any thread associated)
-				std::thread** pOwnerThread = pOwner->getPPThread();
-				if (pOwnerThread != nullptr && ((*pOwnerThread) != nullptr) && (*pOwnerThread)->joinable()) {
-					(*pOwnerThread)->join();
+				unsigned long long cursor{ 0 };
+				if (!SINGLE_CONSUMER && pOwner->consumerGroup != nullptr) {
+					// A worker waits for the items not handed out yet
+					target = currentClaimSegment(pOwner->consumerGroup, cursor);
+					segmentIndex = cursor >> CLAIM_OFFSET_BITS;
+				}
+				else {
+					target = currentReadSegment(pOwner);
+					segmentIndex = pOwner->bufferSegmentReadIndex;
+				}
+				if (target != nullptr) {
+					if (!(target->tryPin())) {
+						return true;	// Being dropped, look again
+					}
+					bool hasNewer{ false };
+					if (ownedSegmentAt(pOwner, segmentIndex, hasNewer) != target) {
+						target->unpin();
+						return true;
+					}
+					pinned = target;
+					readIndex = (pOwner->consumerGroup != nullptr) ?
+						(cursor & CLAIM_OFFSET_MASK) : pOwner->bufferSegmentItemsArrayReadIndex.load();
 				}
-				// Decrease the owner's reference count by 1
-				pOwner->decrementRefCount();
 			}
-			it = owners->erase(it);
 		}
-		// Remove currentOwner
-		currentOwner = nullptr;
-		// free space occupied by items array
-		if (items != nullptr) {
-			delete items;
-			items = nullptr;
+		OwnedSegmentIndex<T>* pIndex = (target == nullptr) ? segmentIndexOf(pOwner, true) : nullptr;
+		ParkingWord& word = (target != nullptr) ? target->publications : pIndex->appended;
+		std::atomic<std::uint32_t>& parkedReaders = (target != nullptr) ? target->parkedReaders : pIndex->parkedReaders;
+
+		std::uint32_t ticket = word.load();
+		parkedReaders.fetch_add(1, std::memory_order_seq_cst);
+		asymmetricHeavyFence();
+		bool changed{ false };
+		if (target != nullptr) {
+			changed = target->writingIndex.load(std::memory_order_acquire) > readIndex ||
+				target->nextInChain.load(std::memory_order_acquire) != nullptr;
+		}
+		else {
+			std::shared_lock<std::shared_mutex> lock(pIndex->mutex);
+			changed = (pIndex->recycled + pIndex->segments.size()) > segmentIndex;
 		}
-		// remove mutexes
-		delete writerMutex;
-		writerMutex = nullptr;
-		delete readerMutex;
-		readerMutex = nullptr;
+		bool inTime{ true };
+		if (!changed) {
+			inTime = word.wait(ticket, deadline);
+		}
+		parkedReaders.fetch_sub(1, std::memory_order_release);
+		if (pinned != nullptr) {
+			pinned->unpin();
+		}
+		return inTime;
 	}
 
 	/**
-	* @brief Constructor to initialize a buffer segment of size `size` and initialize the owners set
+	* @brief Get the capacity of a buffer segment, a compile-time constant with a fixed capacity (see `BufferPolicy`).
 	*/
-	BufferSegment(
-		unsigned long long size
-	) : items((T*)malloc(sizeof(T)* size)),
-		size(size), writingIndex(0),
-		currentOwner(nullptr),
-		inWrite(false),
-		inRead(false),
-		owners(new std::list<BufferSegmentOwner*>) {}
+	static ull capacityOf(const BufferSegment<T>* bufferSeg) {
+		if constexpr (FIXED_CAPACITY != 0) {
+			return FIXED_CAPACITY;
+		}
+		else {
+			return bufferSeg->size;
+		}
+	}
 
 	/**
-	* @brief Constructor to initialize a buffer segment of size `size` with its owner `pOwner`
+	* @brief Get the number of bytes from `position` to the header of the record which would be written there, so the
+	* payload following the header is aligned to `RECORD_ALIGNMENT`.
 	*
-	* @param size The size of the buffer segment.
-	* @param pOwner Pointer to the owner (a `BufferSegmentOwner`)
+	* The padding depends only on the address, hence the writer and the readers of a record agree on it. The `items`
+	* array of a buffer segment starts at a cache line (see `BufferSegment::create()`), which is aligned to at least
+	* `RECORD_ALIGNMENT`.
 	*/
-	BufferSegment(
-		unsigned long long size, BufferSegmentOwner* pOwner
-	) : items((T*)malloc(sizeof(T)* size)),
-		size(size),
-		writingIndex(0),
-		currentOwner(pOwner),
-		inWrite(false),
-		inRead(false),
-		owners(new std::list<BufferSegmentOwner*>) {
-		owners->push_back(pOwner);
-		// increment the reference count
-		pOwner->incrementRefCount();
+	static ull recordPadding(const void* position) {
+		std::uintptr_t address = reinterpret_cast<std::uintptr_t>(position);
+		std::uintptr_t payload = (address + RECORD_HEADER_SIZE + RECORD_ALIGNMENT - 1) & ~(RECORD_ALIGNMENT - 1);
+		return payload - RECORD_HEADER_SIZE - address;
 	}
 
 	/**
-	* @brief Get the buffer segment size
+	* @brief Throws if `pOwner` is not a valid owner with write access.
 	*
-	* @return Size of this buffer segment.
+	* @param pOwner Pointer to the owner to be validated
 	*/
-	int getBufferSegmentSize() {
-		return size;
+	void validateWriter(BufferSegmentOwner* pOwner) {
+		// Check if this owner is pointing to nullptr
+		if (pOwner == nullptr || ((pOwner->getID()) == INVALID_ID)) {
+			throw std::runtime_error("WRITE OP FAILED -- INVALID OWNER -- NULL -- INVALID OWNER UID");
+		}
+		// check if this owner has right access to write to the buffer
+		if (pOwner->getAccessLevel() != BUFFER_SEGMENT_ACCESS_LEVEL::WRITE) {
+			std::ostringstream oss;
+			oss << "BufferSegmentOwner: 0x" << std::hex << reinterpret_cast<uintptr_t>(pOwner)
+				<< "-wrong privilege->(REQUIRED: WRITE) on BufferSegment: Unkown";
+			throw std::runtime_error(oss.str());
+		}
 	}
 
 	/**
-	* @brief Assigns a new owner to this buffer segment
-	*
-	* @param pOwner Pointer to the owner (a `BufferSegmentOwner`)
+	* @brief Throws if `pOwner` is a reader detached from a writer's stream for falling behind, or a consumer group
+	* (whose workers are read from instead).
 	*/
-	void ownBufferSegment(BufferSegmentOwner* pOwner) {
-		// Check if this owner (pOwner) has a valid ID
-		if (pOwner->getID() == INVALID_ID) {
-			throw std::runtime_error("ERR -- owner rejected -- invalid id");
+	void validateAttachedReader(BufferSegmentOwner* pOwner) {
+		if (pOwner->detached.load(std::memory_order_acquire)) {
+			throw std::runtime_error(
+				"ERR: READ OP FAILED -- READER DETACHED -- FELL BEHIND BY MORE THAN " +
+				std::to_string(pOwner->maxLagSegments) + " BUFFER SEGMENTS"
+			);
 		}
-		// Check if this owner already exists in the set of owners
-		if (!(doesOwnerExist(pOwner))) {
-			owners->push_back(pOwner);
-			// Increase reference count by one for the owner
-			pOwner->incrementRefCount();
+		if (pOwner->isConsumerGroup) {
+			throw std::runtime_error("ERR: READ OP FAILED -- READ THROUGH THE WORKERS OF THE CONSUMER GROUP");
 		}
-		if (!(doesOwnerExist(pOwner))) {
-			owners->push_back(pOwner);
-			// Increment reference count of the owner
-			pOwner->incrementRefCount();
+	}
+
+	/**
+	* @brief Attaches a new reader or consumer group to the stream of `pWriter` (see `attachReader()`,
+	* `createConsumerGroup()`).
+	*/
+	BufferSegmentOwner* attachCursor(
+		BufferSegmentOwner* pWriter, const std::string& name, unsigned long long maxLagSegments,
+		READER_LAG_POLICY lagPolicy, bool isConsumerGroup, unsigned long long sliceItems
+	) {
+		validateWriter(pWriter);
+		if (pWriter->isPartOfReaderWriterPair) {
+			throw std::runtime_error("ERR: ATTACH FAILED -- THE WRITER OF A READER-WRITER PAIR HAS A SINGLE READER");
 		}
-		else {
-			throw std::runtime_error("ERR -- owner rejected -- owner already present");
+		OwnedSegmentIndex<T>* pIndex = segmentIndexOf(pWriter, true);
+		BufferSegmentOwner* pReader = new BufferSegmentOwner(name, BUFFER_SEGMENT_ACCESS_LEVEL::READ);
+		pReader->assignUID();
+		pReader->broadcastWriter = pWriter;
+		pReader->maxLagSegments = maxLagSegments;
+		pReader->lagPolicy = lagPolicy;
+		pReader->isConsumerGroup = isConsumerGroup;
+		pReader->sliceItems = sliceItems;
+		{
+			std::lock_guard<std::mutex> lock(attachedReadersMutex);
+			attachedReaders.push_back(pReader);
 		}
+		{
+			std::unique_lock<std::shared_mutex> lock(pIndex->mutex);
+			pReader->bufferSegmentReadIndex = pIndex->recycled;
+			pReader->claimCursor.store(pIndex->recycled << CLAIM_OFFSET_BITS, std::memory_order_release);
+			pIndex->readers.push_back(pReader);
+		}
+		// The reader looks the writer's buffer segments up through the writer's index
+		pReader->segmentIndex.store(pIndex, std::memory_order_release);
+		return pReader;
 	}
 
 	/**
-	* @brief Checks if the owner exists for this buffer segment
+	* @brief Get the buffer segment a consumer group hands items out from, moving the group's claim cursor past the
+	* buffer segments handed out completely. Called within an epoch.
 	*
-	* @param pOwner Pointer to the owner (a `BufferSegmentOwner`)
+	* @param pGroup Pointer to the consumer group
+	* @param cursor Set to the claim cursor the buffer segment was found at
+	* @return Pointer to the buffer segment or nullptr if the writer has no buffer segment to read.
 	*/
-	bool doesOwnerExist(BufferSegmentOwner* pOwner) {
-		if (pOwner != nullptr) {
-			auto ownerID = pOwner->getID();
-			// Read all owners
-			for (auto it = owners->begin(); it != owners->end(); ++it) {
-				// Iterate through the set to find an owner with the matching ID
-				if (*it != nullptr && ((*it)->getID()) == ownerID) {
-					return true;
+	BufferSegment<T>* currentClaimSegment(BufferSegmentOwner* pGroup, unsigned long long& cursor) {
+		while (true) {
+			cursor = pGroup->claimCursor.load(std::memory_order_acquire);
+			unsigned long long segmentIndex = cursor >> CLAIM_OFFSET_BITS;
+			bool hasNewer{ false };
+			BufferSegment<T>* claimSeg = ownedSegmentAt(pGroup, segmentIndex, hasNewer);
+			if (claimSeg == nullptr && hasNewer) {
+				// Pruned before it was handed out (`READER_LAG_POLICY::SKIP`)
+				if (pGroup->detached.load(std::memory_order_acquire)) {
+					return nullptr;
 				}
+				unsigned long long firstIndex = firstOwnedIndex(pGroup);
+				if (pGroup->claimCursor.compare_exchange_strong(cursor, firstIndex << CLAIM_OFFSET_BITS)) {
+					pGroup->skippedSegments.fetch_add(firstIndex - segmentIndex, std::memory_order_relaxed);
+				}
+				continue;
 			}
-			return false;
+			if (
+				claimSeg == nullptr || !hasNewer ||
+				(cursor & CLAIM_OFFSET_MASK) < claimSeg->writingIndex.load(std::memory_order_acquire)
+				) {
+				return claimSeg;
+			}
+			// Handed out completely, move to the next buffer segment
+			pGroup->claimCursor.compare_exchange_strong(cursor, (segmentIndex + 1) << CLAIM_OFFSET_BITS);
 		}
-		else {
-			throw std::runtime_error("ERR -- pOwner does not exist (nullptr)");
+	}
+
+	/**
+	* @brief Claims the next slice of the consumer group of `pWorker` and hands it out to the worker as its read view
+	* (see `acquireRead()`).
+	*/
+	std::span<const T> claimRead(BufferSegmentOwner* pWorker, unsigned long long maxItems) {
+		BufferSegmentOwner* pGroup = pWorker->consumerGroup;
+		if (pGroup->detached.load(std::memory_order_acquire)) {
+			validateAttachedReader(pGroup);
+		}
+		if (pGroup->sliceItems != 0) {
+			maxItems = std::min(maxItems, pGroup->sliceItems);
+		}
+		EpochGuard guard;
+		while (true) {
+			unsigned long long cursor{ 0 };
+			BufferSegment<T>* claimSeg = currentClaimSegment(pGroup, cursor);
+			if (claimSeg == nullptr) {
+				return std::span<const T>();
+			}
+			// Pin the buffer segment until the slice is released, unless it is being dropped
+			if (!(claimSeg->tryPin())) {
+				continue;
+			}
+			bool hasNewer{ false };
+			if (ownedSegmentAt(pGroup, cursor >> CLAIM_OFFSET_BITS, hasNewer) != claimSeg) {
+				claimSeg->unpin();
+				continue;
+			}
+			noteReached(claimSeg);
+			unsigned long long offset = cursor & CLAIM_OFFSET_MASK;
+			unsigned long long published = claimSeg->writingIndex.load(std::memory_order_acquire);
+			unsigned long long available = std::min(published - offset, maxItems);
+			if (available == 0) {
+				claimSeg->unpin();
+				return std::span<const T>();
+			}
+			if (!(pGroup->claimCursor.compare_exchange_weak(cursor, cursor + available, std::memory_order_acq_rel))) {
+				// Claimed by another worker
+				claimSeg->unpin();
+				continue;
+			}
+			pWorker->readViewItems = available;
+			pWorker->readViewSegment = claimSeg;
+			return std::span<const T>((claimSeg->items) + offset, available);
 		}
 	}
 
 	/**
-	 * @brief Checks whether two owners are equal by comparing their IDs.
-	 *
-	 * @param o1 The first parameter for BufferSegmentOwner.
-	 * @param o2 The second parameter for BufferSegmentOwner.
-	 * @return true If both the owners match, false otherwise
-	 */
-	bool doOwnersMatch(BufferSegmentOwner* o1, BufferSegmentOwner* o2) {
-		return o1->getID() == o2->getID();
+	* @brief Checks whether a consumer group has published items not handed out yet.
+	*/
+	bool hasUnclaimed(BufferSegmentOwner* pGroup) {
+		if (pGroup->detached.load(std::memory_order_acquire)) {
+			validateAttachedReader(pGroup);
+		}
+		EpochGuard guard;
+		unsigned long long cursor{ 0 };
+		BufferSegment<T>* claimSeg = currentClaimSegment(pGroup, cursor);
+		return claimSeg != nullptr &&
+			(cursor & CLAIM_OFFSET_MASK) < claimSeg->writingIndex.load(std::memory_order_acquire);
 	}
 
 	/**
-	* @brief Revokes ownership of this buffer segment frome owner given by parameter `pOwner`
+	* @brief Get the position of an attached reader in the writer's stream (its claim cursor for a consumer group).
 	*
-	* Any task being performed by this owner will need to be completed before ownership is revoked.
+	* @param segmentIndex Set to the index of the buffer segment being read
+	* @return The index of the next item to be read in that buffer segment.
+	*/
+	unsigned long long readPosition(BufferSegmentOwner* pReader, unsigned long long& segmentIndex) {
+		if (pReader->isConsumerGroup) {
+			unsigned long long cursor = pReader->claimCursor.load(std::memory_order_acquire);
+			segmentIndex = cursor >> CLAIM_OFFSET_BITS;
+			return cursor & CLAIM_OFFSET_MASK;
+		}
+		segmentIndex = pReader->bufferSegmentReadIndex.load();
+		return pReader->bufferSegmentItemsArrayReadIndex.load();
+	}
+
+	/**
+	* @brief Appends `count` items to the last buffer segment owned by `pOwner`, creating new buffer segments (sized by
+	* `nextSegmentSize()`) when the last one is full or is not writable.
 	*
-	* @param pOwner Pointer to the owner (a `BufferSegmentOwner`)
+	* Called by the owner's writer worker and by the bulk `write()`. The owner's `appendMutex` keeps both of them in
+	* order.
+	*
+	* The items are copied with `memcpy` for trivially copyable `T`. Otherwise they are copy constructed in the buffer
+	* segment, or move constructed when `Item` is not const.
+	*
+	* @param items Pointer to the first item to be written.
+	* @param count The number of items to be written.
+	* @param pOwner Pointer to the owner with write access
 	*/
-	void revokeOwnership(BufferSegmentOwner* pOwner) {
-		try {
-			// Check if the requested owner exists in relation to this buffer segment
-			bool doesOwnerExists = doesOwnerExist(pOwner);
-			if (doesOwnerExists) {
-				// Check the reference count of the owner
-				if (pOwner->getRefCount() == 1) {
-					// Check if pOwner is the currentOwner
-					if (doOwnersMatch(pOwner, currentOwner)) {
-						// nullify current owner
-						currentOwner = nullptr;
-					}
-					// Decrease the reference count by 1
-					pOwner->decrementRefCount();
-					// Remove owner from the set of owners for this buffer segment
-					owners->remove(pOwner);
-					// Delete the owner (the destructor of `BufferSegmentOwner` handles its thread task completion and
-					// deletion, so, no explicit or double deletion has to be done here for that.
-					delete pOwner;
+	template <typename Item> void appendItems(Item* items, unsigned long long count, BufferSegmentOwner* pOwner) {
+		AppendLock appendLock(pOwner->appendMutex);
+		if (pOwner->reservedItems != 0) {
+			throw std::runtime_error("ERR: WRITE OP FAILED -- OWNER HAS AN OUTSTANDING RESERVATION");
+		}
+		// Resolve the last buffer segment of the owner only once for all the items
+		BufferSegment<T>* lastSeg = lastOwnedSegment(pOwner);
+		while (count > 0) {
+			if (lastSeg == nullptr || (lastSeg->writingIndex) == capacityOf(lastSeg) || !(lastSeg->isWritable())) {
+				// Create a new buffer segment of the same size (or the default size for the first one)
+				lastSeg = createBufferSegment(
+					nextSegmentSize(pOwner, lastSeg),
+					pOwner
+				);
+				if (lastSeg == nullptr) {
+					// Over the memory budget, the rest of the items are dropped
+					droppedItems.fetch_add(count, std::memory_order_relaxed);
+					return;
+				}
+			}
+			unsigned long long writingIndex = lastSeg->writingIndex;
+			unsigned long long chunk = std::min(count, capacityOf(lastSeg) - writingIndex);
+			{
+				// acquire lock on this buffer segment once for the whole chunk
+				AppendLock lock(lastSeg->writerMutex);
+				lastSeg->inRead = false;	// Blocking read
+				lastSeg->inWrite = true;
+				T* destination = (lastSeg->items) + writingIndex;
+				if constexpr (std::is_trivially_copyable_v<T>) {
+					std::memcpy(destination, items, chunk * sizeof(T));
+				}
+				else if constexpr (std::is_const_v<Item>) {
+					std::uninitialized_copy_n(items, chunk, destination);
 				}
 				else {
-					// There are more buffer segments having this ownership
-					// Hence, remove only the owner after all its task is finished on this buffer segment
-					std::thread** ppThread = pOwner->getPPThread();
-					if (ppThread != nullptr && (*ppThread) != nullptr) {
-						if ((*ppThread)->joinable()) {
-							(*ppThread)->join();
-						}
-						// delete thread instance from this buffer segment owner
-						delete* ppThread;
-						(*ppThread) = nullptr;
-					}
-					// Decrease the reference count by 1
-					pOwner->decrementRefCount();
-					// Remove owner from the set of owners for this buffer segment
-					owners->remove(pOwner);
+					std::uninitialized_move_n(items, chunk, destination);
 				}
+				// publish the written items
+				lastSeg->writingIndex.store(writingIndex + chunk, std::memory_order_release);
+				// reset the read and write permissions
+				lastSeg->inRead = false;
+				lastSeg->inWrite = false;
 			}
-		}
-		catch (const std::runtime_error& RE) {
-			throw RE; // re-throw to the caller
+			wakeParkedReaders(lastSeg);
+			items += chunk;
+			count -= chunk;
 		}
 	}
 
 	/**
-	* @brief Checks if this buffer segment is in use.
+	* @brief Get the index of the buffer segments owned by the owner, creating it if `create` is true.
 	*
-	* @return `true` if this buffer segment is in use else `false`
+	* The index is created once per owner (under `ownedSegmentsMutex`) and cached in the owner, so later lookups do
+	* not touch any state shared with the other owners.
+	*
+	* @param pOwner Pointer to the owner
+	* @param create Whether to create the index if the owner has none yet
+	* @return The owner's index or nullptr if it has none and `create` is false.
 	*/
-	bool isBufferSegmentInUse() {
-		return inRead || inWrite;
+	OwnedSegmentIndex<T>* segmentIndexOf(BufferSegmentOwner* pOwner, bool create) {
+		OwnerSegmentIndex* pIndex = pOwner->segmentIndex.load(std::memory_order_acquire);
+		if (pIndex == nullptr && create) {
+			std::lock_guard<std::mutex> lock(ownedSegmentsMutex);
+			pIndex = pOwner->segmentIndex.load(std::memory_order_relaxed);
+			if (pIndex == nullptr) {
+				std::unique_ptr<OwnedSegmentIndex<T>>& entry = ownedSegments[pOwner->getID()];
+				entry.reset(new OwnedSegmentIndex<T>());
+				pIndex = entry.get();
+				pOwner->segmentIndex.store(pIndex, std::memory_order_release);
+			}
+		}
+		// An owner is used in only one buffer, hence its index is always of this buffer's type
+		return static_cast<OwnedSegmentIndex<T>*>(pIndex);
 	}
 
 	/**
-	* @brief Check whether this buffer segment is being read.
+	* @brief Picks the size of the next buffer segment of `pOwner` (see `SegmentSizingPolicy`).
 	*
-	* @return true if this buffer segment is being read.
+	* Called by the owner's writer when `previous` (its last buffer segment) cannot take more items. The write rate is
+	* measured on `previous` (items written since it was handed out) and the reader lag is the number of the owner's
+	* buffer segments not reached by its reader (the partner of a pair, the owner itself otherwise).
+	*
+	* @param pOwner Pointer to the owner with write access
+	* @param previous Pointer to the last buffer segment of the owner or nullptr if it has none
+	* @return The size of the next buffer segment.
 	*/
-	bool isReading() const {
-		return inRead;
+	unsigned long long nextSegmentSize(BufferSegmentOwner* pOwner, BufferSegment<T>* previous) {
+		if constexpr (FIXED_CAPACITY != 0) {
+			return FIXED_CAPACITY;
+		}
+		const SegmentSizingPolicy& policy = sizingPolicy;
+		unsigned long long budget = memoryBudget.load(std::memory_order_acquire);
+		auto clampToPolicy = [&policy, budget](unsigned long long size) {
+			size = std::bit_ceil(std::clamp(size, policy.minSize, policy.maxSize));
+			// A buffer segment never takes more than a quarter of the memory budget
+			while (size > policy.minSize && BufferSegment<T>::footprint(size) > budget / 4) {
+				size /= 2;
+			}
+			return size;
+		};
+		OwnedSegmentIndex<T>* pIndex = segmentIndexOf(pOwner, false);
+		if (previous == nullptr || pIndex == nullptr) {
+			return clampToPolicy(policy.initialSize);
+		}
+
+		// Write rate over the previous buffer segment
+		double elapsedMillis = std::chrono::duration<double, std::milli>(
+			std::chrono::steady_clock::now() - previous->createdAt
+		).count();
+		double written = (double)(previous->writingIndex.load(std::memory_order_relaxed));
+		double rate = written / std::max(elapsedMillis, 0.001);
+
+		// Reader lag in buffer segments
+		BufferSegmentOwner* pReader = (pOwner->isPartOfReaderWriterPair && pOwner->partner != nullptr)
+			? pOwner->partner : pOwner;
+		double writtenSegments{ 0.0 };
+		{
+			std::shared_lock<std::shared_mutex> lock(pIndex->mutex);
+			writtenSegments = (double)(pIndex->recycled + pIndex->segments.size());
+		}
+		double lag = std::max(0.0, writtenSegments - 1.0 - (double)(pReader->bufferSegmentReadIndex.load()));
+
+		if (pIndex->hasStatistics) {
+			pIndex->writeRate = policy.smoothing * rate + (1.0 - policy.smoothing) * pIndex->writeRate;
+			pIndex->readerLag = policy.smoothing * lag + (1.0 - policy.smoothing) * pIndex->readerLag;
+		}
+		else {
+			pIndex->writeRate = rate;
+			pIndex->readerLag = lag;
+			pIndex->hasStatistics = true;
+		}
+
+		unsigned long long size = previous->size;
+		double projectedFillMillis = (double)size / std::max(pIndex->writeRate, 1e-9);
+		if (projectedFillMillis < policy.targetFillMillis / 2.0 || pIndex->readerLag > policy.lagThreshold) {
+			size *= 2;		// Sustained burst, fewer and larger buffer segments
+		}
+		else if (projectedFillMillis > policy.targetFillMillis * 2.0 && pIndex->readerLag < 1.0) {
+			size /= 2;		// Light traffic, stop holding memory that is not used
+		}
+		return clampToPolicy(size);
 	}
 
 	/**
-	* @brief Check whether this buffer segment is being written to.
+	* @brief Creates a buffer segment of `size` items owned by `pOwner` and appends it to the buffer.
 	*
-	* @return true if any piece of data is being written to this buffer segment.
+	* The slot in the buffer is claimed by an atomic fetch-add on the segment directory and only the owner's own index
+	* is locked, so producers with different owners never wait for each other here.
+	*
+	* @param size The size of the buffer segment.
+	* @param pOwner Pointer to the owner of the buffer segment
+	* @return Pointer to the newly created buffer segment or nullptr if it does not fit in the memory budget and the
+	* overflow policy drops the items being written.
 	*/
-	bool isWriting() const {
-		return inWrite;
+	BufferSegment<T>* createBufferSegment(unsigned long long size, BufferSegmentOwner* pOwner) {
+		BufferSegment<T>* bufferSeg = allocateBufferSegment(size);
+		if (bufferSeg == nullptr) {
+			return nullptr;
+		}
+		linkBufferSegment(bufferSeg, pOwner);
+		return bufferSeg;
 	}
 
 	/**
-	* @brief Checks if this buffer segment is writable or not.
+	* @brief Makes `pOwner` (and the reader of its pair) own a buffer segment without owners and appends it to the
+	* buffer and to the owner's chain.
 	*
-	* @return true if this buffer segment is writable, false otherwise.
+	* @param bufferSeg Pointer to the buffer segment
+	* @param pOwner Pointer to the owner of the buffer segment
 	*/
-	bool isWritable() {
-		return
-			!inWrite								// Places the condition that when an owner is writing to this
-			// buffer segment, no other owners are allowed to write to the
-			// same.
-			||
-			(writingIndex == 0);				// Places the condition that if there are contents already
-		// written to this buffer segment and the reader associated with
-		// the writer has not finished/started reading. The reader
-		// associated with the writer is responsible to clear the buffer
-		// segment `items` array and reset the `writingIndex` to zero(0).
-		// The associated reader will read quickly, detach, return contents
-		// and wait for other reader owners to finish reading the contents
-		// of this buffer segment and then the associated reader thread will
-		// join.
+	void linkBufferSegment(BufferSegment<T>* bufferSeg, BufferSegmentOwner* pOwner) {
+		bufferSeg->assignOwner(pOwner);
+		BufferSegmentOwner* pPartner = pOwner->isPartOfReaderWriterPair ? pOwner->partner : nullptr;
+		if (pPartner != nullptr) {
+			// The reader of a pair owns every buffer segment of its writer
+			if (!(pPartner->hasUID())) {
+				pPartner->assignUID();
+			}
+			bufferSeg->ownBufferSegment(pPartner);
+		}
+		OwnedSegmentIndex<T>* pIndex = segmentIndexOf(pOwner, true);
+		BufferSegment<T>* previous{ nullptr };
+		{
+			std::unique_lock<std::shared_mutex> lock(pIndex->mutex);
+			// Claiming the slot under the owner's lock keeps the owner's index in the order of the buffer
+			bufferSeg->directoryIndex = bufferSegments.append(bufferSeg);
+			bufferSeg->createdAt = std::chrono::steady_clock::now();
+			if (!(pIndex->segments.empty())) {
+				// Link the new buffer segment to the owner's chain
+				previous = pIndex->segments.back();
+				previous->nextInChain.store(bufferSeg, std::memory_order_release);
+			}
+			pIndex->segments.push_back(bufferSeg);
+		}
+		OwnedSegmentIndex<T>* pPartnerIndex{ nullptr };
+		if (pPartner != nullptr) {
+			pPartnerIndex = segmentIndexOf(pPartner, true);
+			std::unique_lock<std::shared_mutex> lock(pPartnerIndex->mutex);
+			pPartnerIndex->segments.push_back(bufferSeg);
+		}
+		// Wake the readers waiting for the writer to move on or to start
+		if (previous != nullptr) {
+			wakeParkedReaders(previous);
+		}
+		wakeParkedReaders(pIndex);
+		if (pPartnerIndex != nullptr) {
+			wakeParkedReaders(pPartnerIndex);
+		}
 	}
-};
-
-/**
-* @class DynBuffer
-* @brief Used to create and manage a dynamic buffer
-*
-* This class employs a single thread which overlooks entire tasks inside it. For reference use the name "DynBufferThread".
-*
-* Use this class as the interface for detailed level operations on the buffer segment. This class holds more than one
-* instance of the `BufferSegment` class in a list of `BufferSegment**`.
-*
-* A dynamic buffer stores several buffer segments in a linear fashion. Some of the threads might be reading a buffer
-* segment values, some might try to write to it. So in this list of buffer segments, some owners might still be accessing
-* the buffer segment, some might have finished working with the buffer and optionally moves on to the next buffer segment
-* (watching out if they have their ownership in the next buffer segment).
-* Thus the incoming or outgoing data through the Dynamic Buffer will be stored in a continuous, linear, zero-based
-* indexing fashion so as to maintain data consistency.
-*
-* The actual purpose of having a `DynBuffer` class is to create a dynamic buffer which will allow to create more efficient
-* buffer that employs Pruner thread(s) divided among "regions" to free resources (e.g., `items` dynamic array of
-* `BufferSegment` class) and erase the `BufferSegment` instance from the list of `BufferSegment`s.
-* A buffer segment of any size can be requested and created any time the owner wants to.
-* A "region" for the Pruner threads is defined as the chunk of `BufferSegment` list (`*bufferSegments`) which will be
-* looked over by the Pruner thread employed by the `DynBuffer` dynamic buffer to cleanup the `BufferSegment`s and erase
-* that `BufferSegment` instance itself from the `*bufferSegments` list. The number of Pruner threads may increase if the
-* size of the data being read is too large which will create a requirement for more `BufferSegment`s. So if there are no
-* owners to a buffer, it will be cleaned & removed by the Pruner thread.
-*
-* NOTE 1: A buffer segment not having any active threads reading or writing does not mean that it will not have owners. If
-* it has owners, it will still remain in the memory because it is unpredictable whether the owner's thread will be used
-* again. Only when the ownership is revoked, and there are zero(0) owners to that buffer segment, the buffer segment is
-* dropped.
-* NOTE 2: Whenever a new owner arrives with a write permission, a new buffer segment is created and owned by this new
-* owner. An owner with a write permission handles writing to the buffer segments it owns single handedly and no extra
-* owner is required to write the contents that the original owner was supposed to write.
-* NOTE 3: Any number of owners can read from the buffer. There is no restriction on reading a buffer segment except when
-* another owner is writing to the buffer segment.
-* NOTE 4: If an owner has finished writing to a specific buffer segment, all other waiting owners will read from the buffer
-* when write operations are over.
-*/
-template <typename T> class DynBuffer {
-
-public:
-
-	// Delete copy constructor
-	DynBuffer(const DynBuffer&) = delete;
-	// Delete assignment operator
-	DynBuffer& operator=(const DynBuffer&) = delete;
 
 	/**
-	* @brief Destructor
+	* @brief Get a reset buffer segment of at least `size` items within the memory budget.
 	*
-	* NOTE: ORDER OF DELETION AND NON-DANGLING MATTERS THE MOST
+	* A recycled buffer segment is reused if one fits. Otherwise the memory of a new one is charged to the budget,
+	* freeing the parked buffer segments first and applying the overflow policy when the budget is still exhausted.
 	*
-	* WARNING: DO NOT DELETE THIS BUFFER ITSELF
-	* THE DESTRUCTOR HAS TO BE CALLED ON AN INSTANCE OF THIS CLASS MANUALLY OR MANAGED BY A SMART POINTER
+	* @param size The size of the buffer segment.
+	* @param applyPolicy Apply the overflow policy when the budget is exhausted, nullptr is returned otherwise.
+	* @return Pointer to the buffer segment (without owners) or nullptr if the items being written are to be dropped.
 	*/
-	~DynBuffer() {
-		// Free buffer segments, clear and delete
-		for (auto it = bufferSegments->begin(); it != bufferSegments->end();) {
-			// Ensure *it is not null before dereferencing
-			if (*it != nullptr) {
-				delete* it;					// Delete the BufferSegment object
-				*it = nullptr;
+	BufferSegment<T>* allocateBufferSegment(unsigned long long size, bool applyPolicy = true) {
+		if constexpr (FIXED_CAPACITY != 0) {
+			if (size > FIXED_CAPACITY) {
+				throw std::runtime_error(
+					"ERR: " + std::to_string(size) + " ITEMS EXCEED THE BUFFER SEGMENT CAPACITY OF THE BUFFER POLICY"
+				);
+			}
+			size = FIXED_CAPACITY;
+		}
+		unsigned long long bytes = BufferSegment<T>::footprint(size);
+		if (bytes > memoryBudget.load(std::memory_order_acquire)) {
+			throw BufferOverflowError("ERR: BUFFER SEGMENT OF " + std::to_string(size) + " ITEMS EXCEEDS THE MEMORY BUDGET");
+		}
+		bool pruned{ false };
+		while (true) {
+			// Read before trying so that a release in between is not missed by `waitForMemory()`
+			unsigned long long generation = memoryGeneration.load(std::memory_order_acquire);
+			BufferSegment<T>* bufferSeg = segmentPool.take(size);
+			if (bufferSeg == nullptr && !(limbo.isEmpty()) && limbo.collect() > 0) {
+				// The recycled buffer segments are parked once the readers have moved on
+				bufferSeg = segmentPool.take(size);
+			}
+			if (bufferSeg != nullptr) {
+				return bufferSeg;
+			}
+			if (chargeMemory(bytes)) {
+				return BufferSegment<T>::create(size);
+			}
+			// Free the buffer segments retired earlier if the readers have moved on
+			if (limbo.collect() > 0) {
+				continue;
+			}
+			// The parked buffer segments are not in use, free them before anything else
+			if (releaseParkedSegment()) {
+				continue;
+			}
+			// Then reclaim what the readers have consumed since the last prunning pass
+			if (!pruned) {
+				pruned = true;
+				if (prune() > 0) {
+					continue;
+				}
+			}
+			if (!applyPolicy) {
+				return nullptr;
+			}
+			switch (overflowPolicy.load(std::memory_order_acquire)) {
+			case BUFFER_OVERFLOW_POLICY::FAIL:
+				throw BufferOverflowError("ERR: MEMORY BUDGET EXCEEDED -- " + std::to_string(memoryInUse.load()) +
+					" BYTES IN USE");
+			case BUFFER_OVERFLOW_POLICY::DROP_OLDEST:
+				if (dropOldestSegment()) {
+					continue;
+				}
+				return nullptr;
+			case BUFFER_OVERFLOW_POLICY::DROP_NEWEST:
+				return nullptr;
+			case BUFFER_OVERFLOW_POLICY::BLOCK:
+			default:
+				waitForMemory(generation);
+				break;
 			}
-			it = bufferSegments->erase(it);		// Erase the pointer from the set and move to the next element
 		}
-		delete bufferSegments;
-		bufferSegments = nullptr;
 	}
 
 	/**
-	* @brief Default constructor to instantiate a dynamic buffer of zero size.
+	* @brief Charges `bytes` to the memory budget.
+	*
+	* @return false if the budget would be exceeded (nothing is charged then).
 	*/
-	DynBuffer() : bufferSegments(new std::list<BufferSegment<T>*>()) {}
+	bool chargeMemory(unsigned long long bytes) {
+		unsigned long long budget = memoryBudget.load(std::memory_order_acquire);
+		unsigned long long inUse = memoryInUse.load(std::memory_order_relaxed);
+		do {
+			if (inUse > budget || bytes > budget - inUse) {
+				return false;
+			}
+		} while (!(memoryInUse.compare_exchange_weak(inUse, inUse + bytes, std::memory_order_acq_rel)));
+		return true;
+	}
 
 	/**
-	* @brief Constructor to instantiate a dynamic buffer with given initial size and owner.
+	* @brief Deletes a buffer segment which is not in the buffer anymore and gives its memory back to the budget, once
+	* no reader can be looking at it.
 	*
-	* @param initialSize The size of the buffer segment at the time of instantiation of dynamic buffer
-	* (single buffer segment is created)
-	* @param pOwner Pointer to the owner of the buffer segment to be assigned to the buffer segment
+	* @param bufferSeg Pointer to the reset buffer segment
 	*/
-	DynBuffer(int initialSize, BufferSegmentOwner* pOwner) :
-		bufferSegments(new std::list<BufferSegment<T>*>()) {
-		// Assign ID to the owner
-		pOwner->assignUID();
-		// Add a buffer to start with size of the buffer segment as `initialSize`
-		BufferSegment<T>* bufferSeg = new BufferSegment<T>(initialSize, pOwner);
-		bufferSegments->push_back(bufferSeg);
+	void freeBufferSegment(BufferSegment<T>* bufferSeg) {
+		limbo.retire([this, bufferSeg]() {
+			// Only the header of a buffer segment with adopted items was charged
+			unsigned long long bytes = BufferSegment<T>::footprint(bufferSeg->releaseItems ? 0 : bufferSeg->size);
+			BufferSegment<T>::destroy(bufferSeg);
+			memoryInUse.fetch_sub(bytes, std::memory_order_acq_rel);
+			notifyMemoryReleased();
+		});
 	}
 
 	/**
-	* @brief Constructor to instantiate a dynamic buffer with give initial size and owner with multiple
-	* buffer segments
+	* @brief Frees one of the buffer segments parked in the pool.
 	*
-	* Note that this constructor will be used rarely.
-	*
-	* @param initialSize The size of the buffer segment at the time of instantiation of dynamic buffer
-	* (multiple buffer segements are created)
-	* @param pOwner Pointer to the owner of the buffer segment to be assigned to the buffer segment
-	* @param counts The number of buffer segments to create
+	* @return false if the pool is empty.
 	*/
-	DynBuffer(
-		int initialSize, BufferSegmentOwner* pOwner, int counts
-	) : bufferSegments(new std::list<BufferSegment<T>*>()) {
-		// Assign ID to the owner
-		pOwner->assignUID();
-		// add `counts` number of buffer segments to the buffer segment list (`*bufferSegments`) of size
-		// `initialSize` with their owner `pOwner`
-		while (counts > 0) {
-			BufferSegment<T>* bufferSeg = new BufferSegment<T>(initialSize, pOwner);
-			bufferSegments->push_back(bufferSeg);
-			--counts;
+	bool releaseParkedSegment() {
+		BufferSegment<T>* bufferSeg = segmentPool.evict();
+		if (bufferSeg == nullptr) {
+			return false;
 		}
+		freeBufferSegment(bufferSeg);
+		return true;
 	}
 
 	/**
-	* @brief This function is used for any mixed use/operation on the buffer.
-	*
-	* The owner is verified before any operation is performed on the buffer.
-	* If there exists no owner as such then this owner will have the ownerhip of the buffer.
+	* @brief Drops the oldest buffer segment of the buffer which is neither being read nor written (policy
+	* `BUFFER_OVERFLOW_POLICY::DROP_OLDEST`). Its unread items are lost, its readers continue with the next one.
 	*
-	* In a write operation or a read and write operations, if, immediately there is a "busy" buffer segment in the
-	* succession or when the next buffer has some owners with read permission then the next buffer segment is not
-	* touched for write operation or read and write operations.Rather, a buffer segment in the list is added,
-	* owner is assined, current owner is set, and a pointer to it is returned immediately for write or read and
-	* write operations. Data is written. If the data being written doesn't fit in, a new buffer segment is created
-	* of the same size and the process is repeated.
+	* The last buffer segment of a writer is never dropped, nor the buffer segments of reader-writer pairs. Only the
+	* oldest buffer segment of each of its owners is dropped, so the logical indices of the newer ones stay the same for
+	* the readers (see `OwnedSegmentIndex::recycled`): when the oldest one is pinned by a reader nothing is dropped.
 	*
-	* @param pOwner Pointer to the owner of the buffer segment in use
-	* @param func The function to execute with the buffer.
-	* @param lambdaArgs The arguments to pass to the function.
-	* @return The result (R) of the function execution.
+	* @return false if there was no buffer segment to drop.
 	*/
-	// TODO
-	template <
-		typename R,                              // Return Type
-		typename... Args>                        // Lambda Arguments Types
-	R use(BufferSegmentOwner* pOwner, std::function<R(Args...)> func, Args&&... lambdaArgs) {
-		try {
-			// Iterator for use within this `use` function.
-			typename std::list<BufferSegment<T>*>::iterator bufferSegsIterator = bufferSegments->begin();
-			// Check if the owner has its ID
-			if (!(pOwner->hasUID())) {
-				// The owner's ID does not exist. Assign an ID to it.
-				pOwner->assignUID();
-				// Certainly it did not own a buffer segment, since an owner without an ID can not own a buffer
-				// segment.
-				// Create new buffer segment and assign the owner.
-				BufferSegment<T>* tempBuffSeg = new BufferSegment<T>(1024, pOwner); // 1024 * sizeof(T) TODO:
-				// Arrange defaults for various operations: Terminal I/O, Application I/O, File I/O, Networking:
-				// Mobile Data, Bluetooth, WiFi
-				// Attach this buffer segment in the list of buffer segments (`bufferSegments`)
-				bufferSegments->push_back(tempBuffSeg);
-				// reset iterator to use the item at the end of the list
-				bufferSegsIterator = bufferSegments->end();
+	bool dropOldestSegment() {
+		EpochGuard guard;
+		ull end = bufferSegments.size();
+		for (ull index = oldestSegmentHint.load(std::memory_order_acquire); index < end; ++index) {
+			if (bufferSegments.isCleared(index)) {
+				// Nothing is left before the first occupied slot
+				ull expected = index;
+				oldestSegmentHint.compare_exchange_strong(expected, index + 1, std::memory_order_acq_rel);
+				continue;
 			}
-			else {
-				/*
-				* Try to find first buffer segment with this owner, if not found, create a buffer segment, assign this
-				* owner and put it in the `bufferSegments` list. Also if no buffer segment exists, create one and
-				* assign the owner.
-				*/
-				for (; bufferSegsIterator != bufferSegments->end(); bufferSegsIterator++) {
-					if ((*bufferSegsIterator)->doesOwnerExist(pOwner)) {
-						// stop here, now `bufferSegsIterator` iterator will be used further
-						break;
-					}
-				}
-				if (bufferSegsIterator == bufferSegments->end()) {
-					// No such buffer segment found, create one
-					BufferSegment<T>* tempBuffSeg = new BufferSegment<T>(1024, pOwner); // 1024 * sizeof(T) TODO:
-					// Arrange defaults for various operations: Terminal I/O, Application I/O, File I/O, Networking:
-					// Mobile Data, Bluetooth, WiFi
-					// Attach this buffer segment in the list of buffer segments (`bufferSegments`)
-					bufferSegments->push_back(tempBuffSeg);
-					// reset iterator to use the item at the end of the list
-					bufferSegsIterator = bufferSegments->end();
+			bool dropped = reclaimSegmentAt(index, [this](BufferSegment<T>* bufferSeg) {
+				BufferSegmentOwner* pOwner = bufferSeg->currentOwner;
+				if (
+					pOwner == nullptr || pOwner->isPartOfReaderWriterPair || bufferSeg->inWrite ||
+					bufferSeg->nextInChain.load(std::memory_order_acquire) == nullptr || !isFrontOfOwners(bufferSeg)
+					) {
+					return false;
 				}
+				droppedItems.fetch_add(bufferSeg->writingIndex.load(std::memory_order_acquire), std::memory_order_relaxed);
+				return true;
+			});
+			if (dropped) {
+				return true;
 			}
-			// Now it is sure that owner exists with its buffer segment
-			/*
-			* WARNING: DO NOT USE DIRECT LOCKS ON ANY RESOURCE/CRITICAL SECTION WITHIN THIS `use` FUNCTION. THE
-			* LOCKING ON RESOURCES ARE TO BE DONE BY OTHER FUNCTIONS AND OVERLOADED OPERATORS SUCH AS WRITE,
-			* READ, +, -, << (READ IN), >> (READ OUT), ETC. AND THESE SPECIFIED FUNCTIONS ARE USED ONLY WITHIN THE
-			* PROVIDED LAMBDA IN THE ARGUMENTS. USE OF FUNCTIONS ASSOCIATED WITH MODIFICATION OF BUFFER SEGMENT
-			* AND FUNCTIONS THAT ALLOW READING OF DATA FROM A BUFFER SEGMENT ARE RESPONSIBLE FOR SETTING THE
-			* `INWRITE` AND `INREAD` BOOL VARIABLES BY USE OF LOCK.
-			*/
+		}
+		return false;
+	}
 
-			// Execute the function
-			if constexpr (std::is_same_v<R, void>) {
-				std::invoke(func, std::forward<Args>(lambdaArgs)...);
+	/**
+	* @brief Checks whether the buffer segment is the oldest one of every owner it belongs to.
+	*
+	* @param bufferSeg Pointer to the buffer segment, which must be marked by `BufferSegment::tryDrop()`
+	*/
+	bool isFrontOfOwners(BufferSegment<T>* bufferSeg) {
+		for (BufferSegmentOwner* pOwner : bufferSeg->owners) {
+			OwnedSegmentIndex<T>* pIndex = segmentIndexOf(pOwner, false);
+			if (pIndex == nullptr) {
+				continue;
 			}
-			else {
-				return std::invoke(func, std::forward<Args>(lambdaArgs)...);
+			std::shared_lock<std::shared_mutex> lock(pIndex->mutex);
+			if (pIndex->segments.empty() || pIndex->segments.front() != bufferSeg) {
+				return false;
 			}
 		}
-		catch (const std::exception& e) {
-			// re-throw to the caller
-			throw e;
+		return true;
+	}
+
+	/**
+	* @brief Blocks the writer until memory may have become available after `generation` was read (a buffer segment
+	* was drained or freed, or the budget was changed).
+	*/
+	void waitForMemory(unsigned long long generation) {
+		blockedWriters.fetch_add(1);
+		requestPrune();
+		{
+			std::unique_lock<std::mutex> lock(memoryMutex);
+			memoryReleased.wait(lock, [this, generation]() {
+				return memoryGeneration.load() != generation;
+			});
+		}
+		blockedWriters.fetch_sub(1);
+	}
+
+	/**
+	* @brief Wakes up the writers blocked on the memory budget.
+	*/
+	void notifyMemoryReleased() {
+		memoryGeneration.fetch_add(1);
+		if (blockedWriters.load() > 0) {
+			std::lock_guard<std::mutex> lock(memoryMutex);
+			memoryReleased.notify_all();
 		}
 	}
 
 	/**
-	* @brief Starts writing a single item to that buffer segment whose `writingIndex` has not exhausted and the owner
-	* of that buffer segment is `*pOwner`.
+	* @brief Assigns `pOwner` as an owner of the buffer segment and records it in the owner's index.
 	*
-	* This is a blocking function. It blocks the read operation on the current buffer segment being operated on by
-	* the owner.
+	* @param bufferSeg Pointer to the buffer segment of this buffer
+	* @param pOwner Pointer to the new owner
+	*/
+	void grantOwnership(BufferSegment<T>* bufferSeg, BufferSegmentOwner* pOwner) {
+		OwnedSegmentIndex<T>* pIndex = segmentIndexOf(pOwner, true);
+		std::unique_lock<std::shared_mutex> lock(pIndex->mutex);
+		bufferSeg->ownBufferSegment(pOwner);
+		// Insert in the order of the buffer
+		auto position = std::upper_bound(
+			pIndex->segments.begin(), pIndex->segments.end(), bufferSeg,
+			[](const BufferSegment<T>* a, const BufferSegment<T>* b) { return a->directoryIndex < b->directoryIndex; }
+		);
+		pIndex->segments.insert(position, bufferSeg);
+	}
+
+	/**
+	* @brief Revokes the ownership of `pOwner` on the buffer segment and removes it from the owner's index.
 	*
-	* No need to dynamically manage the size of the buffer segment here. If new buffer segment is required, a new
-	* buffer segment of required size will be created with the same owner and write access.
+	* @param bufferSeg Pointer to the buffer segment of this buffer
+	* @param pOwner Pointer to the owner
 	*/
-	void write(T item, BufferSegmentOwner* pOwner) {
-		// Lock the critical section that exposes operations on owner's threads
-		std::lock_guard<std::mutex> lock(*(pOwner->ownerThreadMutex));
-		// Check if this owner is pointing to nullptr
-		if (pOwner != nullptr && ((pOwner->getID()) != INVALID_ID)) {
-			// Check for any previous running thread from this owner
-			std::thread** th = pOwner->getPPThread();
-			if (th != nullptr) {
-				if (*th != nullptr) {
-					if ((*th)->joinable()) {								// Check if the thread is joinable
-						(*th)->join();										// Wait for the thread to finish its tasks
-					}
-				}
-				delete* th;                                             // Delete the old thread
-				*th = nullptr;											// Nullify old thread pointer
-
-				// Assign new thread with new task
-				*th = new std::thread([this, item, pOwner]() {
-					// check if this owner has right access to write to the buffer
-					if (pOwner->getAccessLevel() == BUFFER_SEGMENT_ACCESS_LEVEL::WRITE) {
-						// Get the buffer segment with owner as `*pOwner`
-						auto bufferSegsOwned = bufferSegmentsOwned(pOwner);
-						if (bufferSegsOwned == nullptr || bufferSegsOwned->empty()) {
-							// Create one & insert in the list of buffer segment
-							BufferSegment<T>* tempBSeg = new BufferSegment<T>(
-								1024, // TODO: Aap to jaante hee hain
-								pOwner
-							);
-							bufferSegments->push_back(tempBSeg);
-							// No need to loop. Looping would cause two extra operations.
-							// The minimum size of each buffer segment items array is always more than 1 (in any case
-							// like networking, mobile data, terminal I/O, file I/O
-							// Just use this newly created buffer segment
-							{
-								std::lock_guard<std::mutex> lock(*(tempBSeg->writerMutex));
-								tempBSeg->inRead = false;
-								tempBSeg->inWrite = true;
-								(tempBSeg->items)[(tempBSeg->writingIndex)++] = item;
-								tempBSeg->inRead = false;
-								tempBSeg->inWrite = false;
-							}
-						}
-						else {
-							/*
-							 * The buffer is a linear data structure (a list (probably a forward list)). So we do not
-							 * need to iterate over the list of segments owned by the owner, rather move ahead with
-							 * the last one in the list.
-							*/
-							BufferSegment<T>* lastSeg = bufferSegsOwned->back();
-							// Write to buffer segment `lastSeg` only if it is writable
-							if (lastSeg != nullptr) {
-								if (lastSeg->isWritable()) {
-									// Check the capacity of the current buffer segment
-									if ((lastSeg->writingIndex) != (lastSeg->size)) {
-										// writable
-										// acquire lock on this buffer segment
-										std::lock_guard<std::mutex> lock(*(lastSeg->writerMutex));
-										lastSeg->inRead = false;	// Blocking read
-										lastSeg->inWrite = true;
-										// Write the item
-										(lastSeg->items)[(lastSeg->writingIndex)++] = item;
-										// reset the read and write permissions
-										lastSeg->inRead = false;
-										lastSeg->inWrite = false;
-									}
-									else {
-										// Create a new buffer segment and write this item into that buffer
-										BufferSegment<T>* tempBSeg = new BufferSegment<T>(
-											lastSeg->size, pOwner
-										);
-										bufferSegments->push_back(tempBSeg);
-										// acquire a lock on this latest buffer segment
-										std::lock_guard<std::mutex> lock(*(tempBSeg->writerMutex));
-										// set the read and write permissions
-										tempBSeg->inRead = false;
-										tempBSeg->inWrite = true;
-										// Write in this new buffer segment
-										(tempBSeg->items)[(tempBSeg->writingIndex)++] = item;
-										// reset the read and write permissions
-										tempBSeg->inRead = false;
-										tempBSeg->inWrite = false;
-									}
-								}
-							}
-						}
-					}
-					else {
-						std::ostringstream* oss = new std::ostringstream();
-						(*oss) << "BufferSegmentOwner: 0x" << std::hex << reinterpret_cast<uintptr_t>(pOwner)
-							<< "-wrong privilege->(REQUIRED: WRITE) on BufferSegment: Unkown";
-						std::string msg = oss->str();
-						delete oss;
-						oss = nullptr;
-						throw std::runtime_error(msg);
-					}
-					});
-				(*th)->join();
+	void revokeOwnership(BufferSegment<T>* bufferSeg, BufferSegmentOwner* pOwner) {
+		OwnedSegmentIndex<T>* pIndex = segmentIndexOf(pOwner, false);
+		if (pIndex != nullptr) {
+			std::unique_lock<std::shared_mutex> lock(pIndex->mutex);
+			std::erase(pIndex->segments, bufferSeg);
+		}
+		if (pOwner->getRefCount() == 1) {
+			// The owner is deleted along with its last ownership, forget its writer worker and its index
+			{
+				std::lock_guard<std::mutex> ownersLock(writerOwnersMutex);
+				writerOwners.remove(pOwner);
 			}
+			pOwner->segmentIndex.store(nullptr, std::memory_order_release);
 		}
-		else {
-			throw std::runtime_error("WRITE OP FAILED -- INVALID OWNER -- NULL -- INVALID OWNER UID");
+		bufferSeg->revokeOwnership(pOwner);
+	}
+
+	/**
+	* @brief Get the last buffer segment owned by the owner
+	*
+	* @param pOwner Pointer to the owner of the buffer segment
+	* @return Pointer to the last buffer segment owned by `pOwner` or nullptr if none.
+	*/
+	BufferSegment<T>* lastOwnedSegment(BufferSegmentOwner* pOwner) {
+		OwnedSegmentIndex<T>* pIndex = segmentIndexOf(pOwner, false);
+		if (pIndex == nullptr) {
+			return nullptr;
 		}
-		return;
+		std::shared_lock<std::shared_mutex> lock(pIndex->mutex);
+		return pIndex->segments.empty() ? nullptr : pIndex->segments.back();
 	}
 
-	// TODO: Test this function
 	/**
-	* @brief Checks if there is next item avaialable to be read from the buffer.
+	* @brief Get the `index`-th buffer segment owned by the owner
 	*
-	* @return true if there are items to be read from the buffer.
+	* @param pOwner Pointer to the owner of the buffer segment
+	* @param index Zero-based index among the buffer segments owned by `pOwner`
+	* @param hasNewer Set to true if the owner owns a buffer segment after the returned one
+	* @return Pointer to the buffer segment or nullptr if the owner does not own that many buffer segments.
 	*/
-	bool hasNext(BufferSegmentOwner* pOwner) {
-		bool retVal{ false };
-		// Check if the owner is a valid owner
-		if (pOwner != nullptr) {
-			// Check if there is a buffer segment with this owner
-			typename std::list<BufferSegment<T>*>::iterator iter = bufferSegments->begin();
-			// Advance to the buffer segment to be looked for readability
-			while (iter != bufferSegments->end()) {
-				// Find the buffer segment which has this owner and check if this buffer segment has the right
-				// ownership
-				if ((*iter)->doesOwnerExist(pOwner)) {
-					// Check if the buffer segment have already been read upto the written size or not.
-					if (
-						(pOwner->bufferSegmentItemsArrayReadIndex) != (
-							(((*iter)->writingIndex)) == -1 ? (*iter)->size : (*iter)->writingIndex
-							)
-						) {
-						retVal = true;
-					}
-					else {
-						retVal = false; // This is a necessary step as when we exceed the current buffer
-						// segment to check another buffer segment, this retVal will be set to false again
-						// so that the next buffer segment consisting the `writingIndex` or `size` can be
-						// matched against `pOwner->bufferSegmentItemsArrayReadIndex` to know if there are
-						// more items yet to be read or all have been read.
-					}
-				}
-			}
+	BufferSegment<T>* ownedSegmentAt(BufferSegmentOwner* pOwner, unsigned long long index, bool& hasNewer) {
+		hasNewer = false;
+		OwnedSegmentIndex<T>* pIndex = segmentIndexOf(pOwner, false);
+		if (pIndex == nullptr) {
+			return nullptr;
 		}
-		else {
-			throw std::runtime_error("ERR: OWNER NOT FOUND -- nullptr");
+		std::shared_lock<std::shared_mutex> lock(pIndex->mutex);
+		if (index < pIndex->recycled) {
+			// That buffer segment has been recycled already, the newer ones are still there
+			hasNewer = true;
+			return nullptr;
 		}
+		index -= pIndex->recycled;
+		if (index >= pIndex->segments.size()) {
+			return nullptr;
+		}
+		hasNewer = (index + 1) < pIndex->segments.size();
+		return pIndex->segments[index];
+	}
 
-		return retVal;
+	/**
+	* @brief Get the index (among the buffer segments owned by `pOwner`) of the oldest buffer segment not recycled yet
+	*
+	* @param pOwner Pointer to the owner of the buffer segments
+	*/
+	unsigned long long firstOwnedIndex(BufferSegmentOwner* pOwner) {
+		OwnedSegmentIndex<T>* pIndex = segmentIndexOf(pOwner, false);
+		if (pIndex == nullptr) {
+			return 0;
+		}
+		std::shared_lock<std::shared_mutex> lock(pIndex->mutex);
+		return pIndex->recycled;
 	}
 
 	/**
- * @brief Reads the next item from the current/next buffer segment owned by pOwner
- */
-	const T read(BufferSegmentOwner* pOwner) {
-		try {
-			// Validate owner pointer
-			if (pOwner == nullptr) {
-				throw std::runtime_error("ERR: OWNER NOT FOUND -- nullptr");
+	* @brief Removes a drained buffer segment from the buffer and parks it in the pool for reuse.
+	*
+	* The buffer segment is removed from its owners' indices and its slot in the segment directory is cleared. It must
+	* not be read by anyone anymore, but a reader may still have found it in the directory and be trying to pin it. So it
+	* is only parked once no reader can hold it anymore (see `EpochLimbo`), marked by `BufferSegment::tryDrop()` until
+	* then so that every pin fails.
+	*
+	* @param bufferSeg Pointer to the fully read buffer segment, marked by `BufferSegment::tryDrop()`
+	*/
+	void recycleBufferSegment(BufferSegment<T>* bufferSeg) {
+		for (BufferSegmentOwner* pOwner : bufferSeg->owners) {
+			OwnedSegmentIndex<T>* pIndex = segmentIndexOf(pOwner, false);
+			if (pIndex == nullptr) {
+				continue;
 			}
-
-			// Get the list of buffer segments owned by this owner
-			std::list<BufferSegment<T>*>* segsInRead = bufferSegmentsOwned(pOwner);
-
-			// Check if there is a buffer segment in the list to be read
-			if(segsInRead == nullptr) {
-				throw std::runtime_error("ERR: NO SUCH BUFFER ENTRY -- NO ASSOCIATED BUFFER");
+			std::unique_lock<std::shared_mutex> lock(pIndex->mutex);
+			auto position = std::find(pIndex->segments.begin(), pIndex->segments.end(), bufferSeg);
+			if (position == pIndex->segments.begin()) {
+				// The oldest one, the indices of the newer buffer segments stay the same
+				++(pIndex->recycled);
 			}
-			else {
-				// Advance by the `advanceBy` number of buffer segments already read till now
-				unsigned long long advanceBy = pOwner->bufferSegmentReadIndex;
-				typename std::list<BufferSegment<T>*>::iterator segInReadIterator = segsInRead->begin();
-				while(advanceBy > 0) {
-					++segInReadIterator;
-					--advanceBy;
-				}
-				/*
-				 * It is sure that `advanceBy` cannot touch 0 but can be zero(0) only when the owner is
-				 * reading the first buffer segment.
-				 */
-				// Get the buffer segment
-				BufferSegment<T>* segInRead = *segInReadIterator;
-				// Check if there are any item left to be read in this buffer segment
-				if((pOwner->bufferSegmentItemsArrayReadIndex) < (segInRead->size)) {
-					// return and advance read index
-					return segInRead->items[(pOwner->bufferSegmentItemsArrayReadIndex)++];
-				}
-				else {
-					/*
-					 * Move to the next buffer segment (if any) o/w throw a runtime error with buffer segment
-					 * not found.
-					 */
-					// Check the iterator
-					if(segInReadIterator == segsInRead->end()) {
-						throw std::runtime_error("ERR: NO BUFFER ENTRY FOR OWNER : " + std::to_string((unsigned long long)((void*)pOwner)));
-					}
-					else {
-						++(pOwner->bufferSegmentReadIndex);
-						(pOwner->bufferSegmentItemsArrayReadIndex) = 0ULL;
-						// advance the buffer segment iterator
-						segInRead = *(++segInReadIterator);
-						// return and advance read index
-						return segInRead->items[(pOwner->bufferSegmentItemsArrayReadIndex)++];
-					}
-				}
+			if (position != pIndex->segments.end()) {
+				pIndex->segments.erase(position);
 			}
-
-			// If no segment was found with the owner
-			throw std::runtime_error("ERR: NO BUFFER ENTRY FOR OWNER : " + std::to_string((unsigned long long)((void*)pOwner)));
 		}
-		catch (const std::exception& e) {
-			throw e; // Re-throw the caught exception
+		bufferSegments.clear(bufferSeg->directoryIndex);
+		bufferSeg->reset();
+		if (bufferSeg->releaseItems) {
+			freeBufferSegment(bufferSeg);
+			return;
 		}
+		limbo.retire([this, bufferSeg]() {
+			bufferSeg->undrop();
+			if (!(segmentPool.give(bufferSeg))) {
+				unsigned long long bytes = BufferSegment<T>::footprint(bufferSeg->size);
+				BufferSegment<T>::destroy(bufferSeg);
+				memoryInUse.fetch_sub(bytes, std::memory_order_acq_rel);
+			}
+			notifyMemoryReleased();
+		});
+		// The writers blocked on the memory budget collect it
+		notifyMemoryReleased();
 	}
 
+	/**
+	* @brief Calls the `onReached` of a buffer segment with adopted items the first time a reader gets to it.
+	*/
+	void noteReached(BufferSegment<T>* bufferSeg) {
+		if (
+			bufferSeg->onReached && !(bufferSeg->reached.load(std::memory_order_acquire)) &&
+			!(bufferSeg->reached.exchange(true, std::memory_order_acq_rel))
+			) {
+			bufferSeg->onReached();
+		}
+	}
 
-	// TODO: Test this function
 	/**
-	* @brief Reads all items from the buffer.
+	* @brief Get the buffer segment `pOwner` is reading from.
 	*
-	* Returns all items from the buffer owned by `pOwner`. Use while loop to get the next buffer segment's
-	* items.
-	*
-	* @param pOwner Pointer to the owner of the buffer segments to be read.
+	* When the owner has read everything published in its current buffer segment and a newer buffer segment of the
+	* owner exists, the writer will never write to the current one again, so the owner advances to the next buffer
+	* segment.
 	*
-	* @return A dynamic sized array of type T with contents of the buffer segment copied to it.
+	* @param pOwner Pointer to the owner of the buffer segments being read.
+	* @return Pointer to the buffer segment being read or nullptr if the owner has no buffer segment to read.
 	*/
-	const T* read(BufferSegmentOwner* pOwner, unsigned long long bufferSegmentIndex) {
-		/*
-		* Unrestricted read except when the buffer segment is being written to. Thus there is no use of owner's
-		* thread mutex here.
-		*/
-		try {
-			// Validate owner pointer
-			if (pOwner != nullptr) {
-				// Check if there is a buffer segment with this owner
-				typename std::list<BufferSegment<T>*>::iterator iter = bufferSegments->begin();
-				// Advance to the buffer segment to be read
-				unsigned long long advanceBy = pOwner->bufferSegmentReadIndex;
-				while (iter != bufferSegments->end()) {
-					// Find the buffer segment which has this owner and check if this buffer segment has the
-					// right ownership.
-					if ((*iter)->doesOwnerExist(pOwner)) {
-						if (advanceBy < 0) {
-							break;
-						}
-						else {
-							--advanceBy;
-						}
+	BufferSegment<T>* currentReadSegment(BufferSegmentOwner* pOwner) {
+		while (true) {
+			// Get the buffer segment being read, `hasNewer` is resolved before loading `writingIndex` since the last
+			// items of this buffer segment are published before the newer buffer segment is created
+			bool hasNewer{ false };
+			BufferSegment<T>* segInRead = ownedSegmentAt(pOwner, pOwner->bufferSegmentReadIndex, hasNewer);
+			if (segInRead == nullptr && hasNewer) {
+				// The buffer segment was recycled, continue with the oldest one still in the buffer
+				unsigned long long firstIndex = firstOwnedIndex(pOwner);
+				if (!SINGLE_CONSUMER && pOwner->broadcastWriter != nullptr) {
+					// A lagging reader skips what was pruned before it read it
+					if (pOwner->detached.load(std::memory_order_acquire)) {
+						return nullptr;
 					}
+					pOwner->skippedSegments.fetch_add(
+						firstIndex - pOwner->bufferSegmentReadIndex, std::memory_order_relaxed
+					);
 				}
-				if (iter != bufferSegments->end()) {
-					++(pOwner->bufferSegmentReadIndex); // This segment has already been read, move to the next.
-					return (*iter)->items;
-				}
-				throw std::runtime_error("NO ITEM FOUND -- END REACHED");
+				pOwner->bufferSegmentReadIndex = firstIndex;
+				(pOwner->bufferSegmentItemsArrayReadIndex) = 0ULL;
+				continue;
 			}
-			else {
-				throw std::runtime_error("ERR: OWNER NOT FOUND -- nullptr");
+			if (
+				segInRead == nullptr || !hasNewer ||
+				(pOwner->bufferSegmentItemsArrayReadIndex) < segInRead->writingIndex.load(std::memory_order_acquire)
+				) {
+				if (segInRead != nullptr) {
+					noteReached(segInRead);
+				}
+				return segInRead;
 			}
+			// Move to the next buffer segment
+			++(pOwner->bufferSegmentReadIndex);
+			(pOwner->bufferSegmentItemsArrayReadIndex) = 0ULL;
 		}
-		catch (const std::exception& e) {
-			throw e;
-		}
-		return nullptr;
 	}
 
-	// TODO: Yet to be implemented
 	/**
-	* @brief Provides direct hook to the buffer segment's dynamic array for use with networking like Bluetooth,
-	* TCP/IP etc. Generally used in `recv` and `send` functions in socket programming.
-	*
-	* WARNING: A POINTER TO THE BUFFER SEGMENT'S (WHOSE OWNER IS `pOwner`) DYNAMIC ARRAY WHICH HOUSES THE ACTUAL
-	* DATA IS SENT TO THE CALLER.
-	*/
-	std::tuple<std::weak_ptr<T*>, int> bufferHookForWrite(BufferSegmentOwner* pOwner) {
-		// Before proceeding with any chnages to the thread, obtain a mutex lock on the owner's thread
-		std::lock_guard<std::mutex> lock(pOwner->ownerThreadMutex);
-		std::tuple<std::weak_ptr<T*>, int> writerHook;
-		// Get the old thread, wait for it to finish its task
-		std::thread** ppOwnerThread = pOwner->getPPThread();
-		std::thread* pOwnerThread = *ppOwnerThread;
-		if (pOwnerThread->joinable()) {
-			pOwnerThread->join();
-			delete* ppOwnerThread;													// delete old thread
-		}
-		// Check for accessed index of the current buffer segment. If this buffer segment's `writingIndex` has
-		// not exceeded the limit then return a pointer to the same buffer segment.
-		// Else go to next buffer segment or create one if not available and return a hook to it.
-		// Get the first buffer segment associated with this owner which is not in use
-		// Associate new thread with function as observing changes in the buffer segment
-		*ppOwnerThread = new std::thread([]() {
-			// Observe the writingIndex
-			});
-
-		return std::move(writerHook);
+	* @brief Starts the pruner thread engine. Called once by every constructor.
+	*/
+	void startPruner() {
+		prunerThreadEngine = std::thread(&DynBuffer::runPruner, this);
 	}
 
-private:
-
-	// Pruner threads related members
-	ull intervalMS = 2000LL;							// This variable holds the time interval in milliseconds 
-	// (default : 2000ms) after which prunning is performed.
-	std::thread prunerThreadEngine;						// The pruner thread engine that handles the prunning
-	// threads. TODO: Assign the prune function to this.
-	std::list<std::thread*>* prunerThreads{ nullptr };
-
-	std::list<BufferSegment<T>*>* bufferSegments{ nullptr };
-	int previousDynamicBufferSize = 0;
-
-	std::list<BufferSegment<T>*>* bufferSegmentsOwnedTemp{ nullptr };
+	/**
+	* @brief Stops and joins the pruner thread engine. Safe to call more than once.
+	*/
+	void stopPruner() {
+		{
+			std::lock_guard<std::mutex> lock(prunerMutex);
+			prunerStopping = true;
+		}
+		prunerWakeup.notify_one();
+		if (prunerThreadEngine.joinable()) {
+			prunerThreadEngine.join();
+		}
+	}
 
 	/**
-	* @brief Get the list of pointers to buffer segments owned by the owner
+	* @brief The loop of the pruner thread engine.
 	*
-	* @param ppOnwer Pointer-to-Pointer to the owner of the buffer segment
-	* @return Pointer to the list of `BufferSegment<T>**` containing the pointer to buffer segments owned by the
-	* `pOwner` or nullptr if none.
+	* A pass runs every `intervalMS` or as soon as one is requested (`requestPrune()`). While writers are blocked on
+	* the memory budget the passes run every millisecond, since every buffer segment the readers finish frees them.
 	*/
-	std::list<BufferSegment<T>*>* bufferSegmentsOwned(BufferSegmentOwner* pOwner) {
-
-
-		bufferSegmentsOwnedTemp = new std::list<BufferSegment<T>*>();
-		for (auto it = bufferSegments->begin(); it != bufferSegments->end(); ++it) {
-			BufferSegment<T>* bSeg = *it;
-			// Check if the given owner exists for this buffer segment
-			if (bSeg->doesOwnerExist(pOwner)) {
-				bufferSegmentsOwnedTemp->push_back(bSeg);
+	void runPruner() {
+		std::unique_lock<std::mutex> lock(prunerMutex);
+		while (!prunerStopping) {
+			std::chrono::milliseconds interval(blockedWriters.load() > 0 ? 1ULL : intervalMS.load());
+			prunerWakeup.wait_for(lock, interval, [this]() { return pruneRequested || prunerStopping; });
+			if (prunerStopping) {
+				break;
 			}
-			else {
-				return nullptr;
+			pruneRequested = false;
+			lock.unlock();
+			prune();
+			lock.lock();
+		}
+	}
+
+	/**
+	* @brief Runs one prunning pass over the "region" of at most `pruneSlotsPerPass` directory slots following the
+	* previous pass, so the cost of a pass is bounded regardless of the size of the buffer.
+	*
+	* Every buffer segment consumed by all of its owners (see `isConsumed()`) is removed from the buffer and parked in
+	* the pool for reuse (or freed when the pool is full). The pass is skipped if another one is running.
+	*
+	* @return The number of buffer segments recycled.
+	*/
+	ull prune() {
+		std::unique_lock<std::mutex> lock(pruneMutex, std::try_to_lock);
+		if (!(lock.owns_lock())) {
+			return 0;
+		}
+		ull begin = oldestSegmentHint.load(std::memory_order_acquire);
+		ull end = bufferSegments.size();
+		if (pruneCursor < begin || pruneCursor >= end) {
+			pruneCursor = begin;	// Wrap around to the oldest buffer segment
+		}
+		ull recycledSegments{ 0 };
+		ull last = std::min(end, pruneCursor + pruneSlotsPerPass);
+		{
+			EpochGuard guard;
+			for (ull index = pruneCursor; index < last; ++index) {
+				if (bufferSegments.isCleared(index)) {
+					// Nothing is left before the first occupied slot
+					ull expected = index;
+					oldestSegmentHint.compare_exchange_strong(expected, index + 1, std::memory_order_acq_rel);
+					continue;
+				}
+				if (reclaimSegmentAt(index, [this](BufferSegment<T>* bufferSeg) { return isConsumed(bufferSeg); })) {
+					++recycledSegments;
+				}
 			}
 		}
+		pruneCursor = last;
+		// The chunks of the directory before the oldest live buffer segment are not looked at by anyone anymore
+		bufferSegments.retireChunksBefore(
+			oldestSegmentHint.load(std::memory_order_acquire),
+			[this](typename SegmentDirectory<T>::Slot* chunk) { limbo.retire([chunk]() { delete[] chunk; }); }
+		);
+		limbo.collect();
+		return recycledSegments;
+	}
 
-		if (bufferSegmentsOwnedTemp->size() != 0) {
-			return bufferSegmentsOwnedTemp;
+	/**
+	* @brief Checks whether every owner of the buffer segment has read it completely.
+	*
+	* The buffer segments of reader-writer pairs are recycled by their reader and the last buffer segment of a writer
+	* may still be written, so neither is ever consumed here. Only the oldest buffer segment of every owner is
+	* considered, so the indices of the newer buffer segments of the owners stay the same.
+	*
+	* When readers are attached to an owner's stream (`attachReader()`) the buffer segment has to be read by all of
+	* them instead of the owner itself. A reader lagging by more than its `maxLagSegments` does not hold it back (see
+	* `READER_LAG_POLICY`).
+	*
+	* @param bufferSeg Pointer to the buffer segment, which must be marked by `BufferSegment::tryDrop()`
+	*/
+	bool isConsumed(BufferSegment<T>* bufferSeg) {
+		BufferSegmentOwner* pWriter = bufferSeg->currentOwner;
+		if (pWriter != nullptr && (pWriter->isPartOfReaderWriterPair ||
+			bufferSeg->nextInChain.load(std::memory_order_acquire) == nullptr)) {
+			return false;
 		}
-		else {
-			delete bufferSegmentsOwnedTemp;
-			bufferSegmentsOwnedTemp = nullptr;
-			return nullptr;
+		if (bufferSeg->inWrite) {
+			return false;
+		}
+		ull published = bufferSeg->writingIndex.load(std::memory_order_acquire);
+		for (BufferSegmentOwner* pOwner : bufferSeg->owners) {
+			OwnedSegmentIndex<T>* pIndex = segmentIndexOf(pOwner, false);
+			if (pIndex == nullptr) {
+				continue;
+			}
+			std::shared_lock<std::shared_mutex> lock(pIndex->mutex);
+			if (pIndex->segments.empty() || pIndex->segments.front() != bufferSeg) {
+				return false;
+			}
+			if (SINGLE_CONSUMER || pIndex->readers.empty()) {
+				if (!hasReadFront(pOwner, pIndex, published)) {
+					return false;
+				}
+				continue;
+			}
+			for (BufferSegmentOwner* pReader : pIndex->readers) {
+				if (pReader->detached.load(std::memory_order_acquire) || hasReadFront(pReader, pIndex, published)) {
+					continue;
+				}
+				// The number of buffer segments the reader is behind the newest one
+				ull readIndex{ 0 };
+				readPosition(pReader, readIndex);
+				readIndex = std::max(readIndex, pIndex->recycled);
+				ull lag = (pIndex->recycled + pIndex->segments.size() - 1) - readIndex;
+				if (pReader->maxLagSegments == 0 || lag <= pReader->maxLagSegments) {
+					return false;
+				}
+				if (pReader->lagPolicy == READER_LAG_POLICY::DETACH) {
+					pReader->detached.store(true, std::memory_order_release);
+				}
+			}
 		}
+		return true;
+	}
 
+	/**
+	* @brief Checks whether `pReader` has read the oldest buffer segment of `pIndex` up to `published`.
+	*
+	* Called with the shared lock of the index held.
+	*/
+	bool hasReadFront(BufferSegmentOwner* pReader, OwnedSegmentIndex<T>* pIndex, ull published) {
+		ull readIndex{ 0 };
+		ull itemsReadIndex = readPosition(pReader, readIndex);
+		if (readIndex > pIndex->recycled) {
+			return true;	// The reader has moved past it
+		}
+		return readIndex == pIndex->recycled && pIndex->segments.size() >= 2 && itemsReadIndex >= published;
 	}
 
 	/**
-	* @brief Employs the pruner threads to prune the irrelevant `BufferSegment`s. The "DynBufferThread" (the main
-	* thread that is responsible for covering all the operations of a dynamic buffer inside it) spawns and destroys the
-	* pruner threads according to the size of the dynamic buffer.
+	* @brief Recycles the buffer segment at `index` of the directory if `isReclaimable` approves it.
 	*
-	* The number of pruner threads will increase with increase in the size of the dynamic buffer.
-	* The number of pruner threads will decrease with decrease in the size of the dynamic buffer.
-	* Every time this function is called, it doesn't destroy the old pruner threads if the size of the buffer did not
-	* change from the past check in an interval or when the size of dynamic buffer increases.
+	* The buffer segment is marked by `BufferSegment::tryDrop()` before it is looked at, so it is not pinned by a
+	* reader nor recycled by anyone else meanwhile.
 	*
-	* Prunning is performed in an interval. The interval will either be shortened or increased as per the size.
+	* @param index The index of the buffer segment in the directory
+	* @param isReclaimable Called with the marked buffer segment
+	* @return true if the buffer segment was recycled.
 	*/
-	void prune() {
-		// Check the size of bufferSegments from the previous size
-		if (previousDynamicBufferSize == bufferSegments->size()) {
-			// The number of pruner threads are not decreased.
-			// Start prunning
-		}
-		else if (previousDynamicBufferSize < bufferSegments->size()) {
-			// Decrease the number of pruner thrads and assign its buffer segment regions.
-			// Start prunning
+	template <typename Predicate> bool reclaimSegmentAt(ull index, Predicate isReclaimable) {
+		BufferSegment<T>* bufferSeg = bufferSegments.at(index);
+		if (bufferSeg == nullptr || !(bufferSeg->tryDrop())) {
+			return false;
 		}
-		else {
-			// Increase the number of pruner thrads and assign its buffer segment regions.
-			// Start prunning
+		if (bufferSegments.at(index) != bufferSeg || !isReclaimable(bufferSeg)) {
+			// Recycled in the meantime, or still in use
+			bufferSeg->undrop();
+			return false;
 		}
-		previousDynamicBufferSize = bufferSegments->size();
+		recycleBufferSegment(bufferSeg);
+		return true;
 	}
 
 	/**
-	* @brief Get the iterator to the next buffer segment
+	* @brief Get the index of the next buffer segment
 	*
+	* @param currentIndex The index of the current buffer segment in the buffer
 	* @param pOwner Pointer to the owner of the next buffer segment in search
 	*
-	* @return `std::list<BufferSegment<T>**>`'s iterator from the next `BufferSegment<T>**` owned by the `pOwner` or
-	* bufferSegments->end() if none
+	* @return The index of the next buffer segment owned by the `pOwner` or `SegmentDirectory<T>::NPOS` if none
 	*/
-	typename std::list<BufferSegment<T>*>::iterator iteratorToNextBufferSegment(
-		typename std::list<BufferSegment<T>*>::iterator iteratorOnCurrentBufferSegment, BufferSegmentOwner* pOwner
-	) {
+	unsigned long long indexOfNextBufferSegment(unsigned long long currentIndex, BufferSegmentOwner* pOwner) {
 		// Search for the next occurrence of a buffer segment owned by the `pOwner`
-		if (iteratorOnCurrentBufferSegment == bufferSegments->end()) {
-			return bufferSegments->end();												// Already at the end
-		}
-		typename std::list<BufferSegment<T>*>::iterator iter = iteratorOnCurrentBufferSegment;
-		++iter;																			// Move to the next element
-
-		for (; iter != bufferSegments->end(); ++iter) {
-			if ((*iter)->doesOwnerExist(pOwner)) {
-				return iter;
+		for (unsigned long long index = currentIndex + 1; index < bufferSegments.size(); ++index) {
+			BufferSegment<T>* bSeg = bufferSegments.at(index);
+			if (bSeg != nullptr && bSeg->doesOwnerExist(pOwner)) {
+				return index;
 			}
 		}
 
-		return bufferSegments->end();
+		return SegmentDirectory<T>::NPOS;
 	}
 
-	typename std::list<BufferSegment<T>*>::iterator iteratorToNextWritableBufferSegment(
-		typename std::list<BufferSegment<T>*>::iterator iteartorOnCurrentBufferSegment, BufferSegmentOwner* pOwner
-	) {
+	/**
+	* @brief Get the index of the next writable buffer segment
+	*
+	* @param currentIndex The index of the current buffer segment in the buffer
+	* @param pOwner Pointer to the owner of the next buffer segment in search
+	*
+	* @return The index of the next writable buffer segment owned by the `pOwner` or `SegmentDirectory<T>::NPOS` if
+	* none
+	*/
+	unsigned long long indexOfNextWritableBufferSegment(unsigned long long currentIndex, BufferSegmentOwner* pOwner) {
 		// Search for the next occurence of a buffer segment owned by the `pOwner` and is writable
-		if (iteartorOnCurrentBufferSegment == bufferSegments->end()) {
-			return bufferSegments->end();												// Already at the end
-		}
-		typename std::list<BufferSegment<T>*>::iterator iter = iteratorToNextBufferSegment;
-		++iter;																			// Move to the next element
-
-		for (; iter != bufferSegments->end(); ++iter) {
-			if ((*iter)->doesOwnerExist(pOwner) && (*iter)->isWritable()) {
-				return iter;
+		for (unsigned long long index = currentIndex + 1; index < bufferSegments.size(); ++index) {
+			BufferSegment<T>* bSeg = bufferSegments.at(index);
+			if (bSeg != nullptr && bSeg->doesOwnerExist(pOwner) && bSeg->isWritable()) {
+				return index;
 			}
 		}
 
-		return bufferSegments->end();
+		return SegmentDirectory<T>::NPOS;
 	}
 
 };
@@ -0,0 +1,302 @@
+/**
+ * @file FdForwarder.h
+ * @brief This header file contains the class definition of a forwarder which moves a byte stream from one file
+ * descriptor to another in the kernel (`sendfile`, `splice`), falling back to copying it through a dynamic buffer.
+ *
+ * @author Rakesh Kumar
+ */
+
+#pragma once
+
+#ifndef FD_FORWARDER_H
+#define FD_FORWARDER_H
+
+#include "DynamicBuffer.h"
+#include "SocketIo.h"
+
+/**
+ * @brief How a forwarder moves the bytes from its input to its output.
+ */
+enum FORWARD_MODE {
+	SENDFILE,				// `sendfile`, the input is a regular file (or a block device)
+	SPLICE,					// `splice`, the input or the output is a pipe
+	SPLICE_THROUGH_PIPE,	// `splice` into a pipe of the forwarder and out of it (e.g. socket to socket)
+	COPY					// `recvInto()` / `sendFrom()` through a dynamic buffer
+};
+
+#if defined(__linux__)
+
+#include <fcntl.h>					// For splice, SPLICE_F_MOVE, pipe2
+#include <sys/sendfile.h>			// For sendfile
+#include <sys/stat.h>				// For fstat, S_ISREG, S_ISFIFO
+#include <unistd.h>					// For close
+#include <cerrno>					// For errno
+#include <cstring>					// For std::strerror
+#include <cstddef>					// For std::byte
+#include <optional>					// For std::optional, calls which would block
+#include <stdexcept>				// For std::runtime_error
+#include <string>					// For std::string
+#include <functional>				// For std::function, registering the owners of the copying fallback
+
+/**
+* @brief Forwards a byte stream from `inFd` to `outFd` (file to socket, pipe to file, socket to socket, ...) without
+* copying it through user space.
+*
+* The bytes are moved by `sendfile` from a regular file, by `splice` when one end is a pipe, and by `splice` through a
+* pipe of the forwarder otherwise. When the kernel does not support the pair of file descriptors the forwarder falls
+* back to copying through a byte stream of a dynamic buffer with scatter-gather calls (`recvInto()`, `sendFrom()`).
+*
+* The bytes never pass through the buffer segments when they are moved in the kernel. Buffer segments are not spliced
+* into pipes (`vmsplice`) since the kernel references their pages until the bytes have been consumed (for TCP, until
+* they are acknowledged), long after the reader has released them and they have been recycled.
+*
+* @tparam Policy The policy of the buffer of the copying fallback (see `BufferPolicy`).
+*/
+template <typename Policy = BufferPolicy<>> class FdForwarder {
+
+public:
+
+	/**
+	* @brief Constructor, picks the mode for the pair of file descriptors. They are not closed by the forwarder.
+	*
+	* @param inFd The file descriptor read from.
+	* @param outFd The file descriptor written to.
+	* @param chunkBytes The maximum number of bytes moved by one call.
+	* @param zeroCopy Move the bytes in the kernel when possible, `FORWARD_MODE::COPY` otherwise.
+	*/
+	FdForwarder(int inFd, int outFd, unsigned long long chunkBytes = 64ULL << 10, bool zeroCopy = true)
+		: inFd(inFd), outFd(outFd), chunkBytes(chunkBytes) {
+		if (chunkBytes == 0) {
+			throw std::runtime_error("ERR: INVALID ARGUMENTS OF A FORWARDER -- 0 BYTES PER CALL");
+		}
+		struct stat input {};
+		struct stat output {};
+		if (::fstat(inFd, &input) != 0 || ::fstat(outFd, &output) != 0) {
+			throw std::runtime_error(std::string("ERR: FAILED TO STAT THE FILE DESCRIPTORS -- ") + std::strerror(errno));
+		}
+		if (!zeroCopy) {
+			mode = FORWARD_MODE::COPY;
+		}
+		else if (S_ISREG(input.st_mode) || S_ISBLK(input.st_mode)) {
+			mode = FORWARD_MODE::SENDFILE;
+		}
+		else if (S_ISFIFO(input.st_mode) || S_ISFIFO(output.st_mode)) {
+			mode = FORWARD_MODE::SPLICE;
+		}
+		else if (::pipe2(pipeFds, O_CLOEXEC) == 0) {
+			mode = FORWARD_MODE::SPLICE_THROUGH_PIPE;
+		}
+		else {
+			mode = FORWARD_MODE::COPY;
+		}
+	}
+
+	/**
+	* @brief Destructor, closes the pipe of the forwarder and frees the buffer of the copying fallback.
+	*/
+	~FdForwarder() {
+		closePipe();
+		delete copyBuffer;
+	}
+
+	FdForwarder(const FdForwarder&) = delete;
+	FdForwarder& operator=(const FdForwarder&) = delete;
+
+	/**
+	* @brief Moves up to `chunkBytes` bytes from the input to the output.
+	*
+	* @return The number of bytes written to the output, 0 once the input has ended and every byte read from it has
+	* been written, no value if a non-blocking file descriptor would block.
+	* @throws std::runtime_error if a read or a write fails.
+	*/
+	std::optional<unsigned long long> pump() {
+		std::optional<unsigned long long> moved;
+		switch (mode) {
+		case FORWARD_MODE::SENDFILE:
+			moved = sendfileChunk();
+			break;
+		case FORWARD_MODE::SPLICE:
+			moved = spliceChunk();
+			break;
+		case FORWARD_MODE::SPLICE_THROUGH_PIPE:
+			moved = spliceThroughPipe();
+			break;
+		case FORWARD_MODE::COPY:
+		default:
+			moved = copyChunk();
+			break;
+		}
+		if (moved.has_value()) {
+			bytesForwarded += *moved;
+		}
+		return moved;
+	}
+
+	/**
+	* @brief Forwards until the input ends (the file descriptors must be blocking).
+	*
+	* @return The number of bytes forwarded by this call.
+	*/
+	unsigned long long run() {
+		unsigned long long total = 0;
+		while (true) {
+			std::optional<unsigned long long> moved = pump();
+			if (moved.has_value() && *moved == 0) {
+				return total;
+			}
+			total += moved.value_or(0);
+		}
+	}
+
+	/**
+	* @brief Get how the bytes are moved, the mode may fall back to `FORWARD_MODE::COPY` on the first call.
+	*/
+	FORWARD_MODE getMode() const {
+		return mode;
+	}
+
+	/**
+	* @brief Get the number of bytes written to the output so far.
+	*/
+	unsigned long long getBytesForwarded() const {
+		return bytesForwarded;
+	}
+
+private:
+
+	int inFd{ -1 };										// The file descriptor read from
+	int outFd{ -1 };									// The file descriptor written to
+	unsigned long long chunkBytes{ 0 };					// The maximum number of bytes moved by one call
+	FORWARD_MODE mode{ FORWARD_MODE::COPY };			// How the bytes are moved
+	int pipeFds[2]{ -1, -1 };							// The pipe of `FORWARD_MODE::SPLICE_THROUGH_PIPE`
+	unsigned long long bytesInPipe{ 0 };				// The bytes spliced into the pipe and not out of it yet
+	bool inputEnded{ false };							// The input has ended
+	unsigned long long bytesForwarded{ 0 };
+
+	// The byte stream of the copying fallback, created when it is first used
+
+	DynBuffer<std::byte, Policy>* copyBuffer{ nullptr };
+	BufferSegmentOwner* copyWriter{ nullptr };
+	BufferSegmentOwner* copyReader{ nullptr };
+
+	/**
+	* @brief Checks whether a failed `sendfile` / `splice` means the pair of file descriptors is not supported (rather
+	* than an I/O error).
+	*/
+	static bool isUnsupported(int error) {
+		return error == EINVAL || error == ENOSYS || error == EOPNOTSUPP || error == EBADF || error == ESPIPE;
+	}
+
+	/**
+	* @brief Handles a failed call, falling back to copying if nothing was moved in the kernel yet.
+	*
+	* @return No value if the call would block.
+	*/
+	std::optional<unsigned long long> onFailure(int error, const char* call) {
+		if (error == EAGAIN || error == EWOULDBLOCK) {
+			return std::nullopt;
+		}
+		if (isUnsupported(error) && bytesForwarded == 0 && bytesInPipe == 0) {
+			closePipe();
+			mode = FORWARD_MODE::COPY;
+			return copyChunk();
+		}
+		throw std::runtime_error(std::string("ERR: ") + call + " FAILED -- " + std::strerror(error));
+	}
+
+	std::optional<unsigned long long> sendfileChunk() {
+		while (true) {
+			ssize_t moved = ::sendfile(outFd, inFd, nullptr, chunkBytes);
+			if (moved >= 0) {
+				return (unsigned long long)moved;
+			}
+			if (errno != EINTR) {
+				return onFailure(errno, "SENDFILE");
+			}
+		}
+	}
+
+	std::optional<unsigned long long> spliceChunk() {
+		while (true) {
+			ssize_t moved = ::splice(inFd, nullptr, outFd, nullptr, chunkBytes, SPLICE_F_MOVE);
+			if (moved >= 0) {
+				return (unsigned long long)moved;
+			}
+			if (errno != EINTR) {
+				return onFailure(errno, "SPLICE");
+			}
+		}
+	}
+
+	/**
+	* @brief Splices the input into the pipe of the forwarder (once the pipe is empty) and the pipe into the output.
+	*/
+	std::optional<unsigned long long> spliceThroughPipe() {
+		if (bytesInPipe == 0 && !inputEnded) {
+			ssize_t moved{ 0 };
+			do {
+				moved = ::splice(inFd, nullptr, pipeFds[1], nullptr, chunkBytes, SPLICE_F_MOVE);
+			} while (moved < 0 && errno == EINTR);
+			if (moved < 0) {
+				return onFailure(errno, "SPLICE");
+			}
+			if (moved == 0) {
+				inputEnded = true;
+			}
+			bytesInPipe = (unsigned long long)moved;
+		}
+		if (bytesInPipe == 0) {
+			return 0ULL;		// The input has ended
+		}
+		ssize_t moved{ 0 };
+		do {
+			moved = ::splice(pipeFds[0], nullptr, outFd, nullptr, bytesInPipe, SPLICE_F_MOVE);
+		} while (moved < 0 && errno == EINTR);
+		if (moved < 0) {
+			return onFailure(errno, "SPLICE");
+		}
+		bytesInPipe -= (unsigned long long)moved;
+		return (unsigned long long)moved;
+	}
+
+	/**
+	* @brief Sends what the buffer of the copying fallback holds, receiving into it first when it is empty.
+	*/
+	std::optional<unsigned long long> copyChunk() {
+		if (copyBuffer == nullptr) {
+			copyBuffer = new DynBuffer<std::byte, Policy>();
+			std::pair<BufferSegmentOwner*, BufferSegmentOwner*> pair =
+				BufferSegmentOwner::getReaderWriterPair("forwarder reader", "forwarder writer");
+			copyReader = pair.first;
+			copyWriter = pair.second;
+			copyBuffer->template use<void>(copyReader, std::function<void()>([]() {}));
+			copyBuffer->template use<void>(copyWriter, std::function<void()>([]() {}));
+		}
+		if (!inputEnded && !(copyBuffer->hasNext(copyReader))) {
+			std::optional<unsigned long long> received = recvInto(inFd, *copyBuffer, copyWriter, chunkBytes);
+			if (!(received.has_value())) {
+				return std::nullopt;
+			}
+			if (*received == 0) {
+				inputEnded = true;
+			}
+		}
+		if (!(copyBuffer->hasNext(copyReader))) {
+			return 0ULL;		// The input has ended
+		}
+		return sendFrom(outFd, *copyBuffer, copyReader);
+	}
+
+	void closePipe() {
+		for (int& fd : pipeFds) {
+			if (fd >= 0) {
+				::close(fd);
+				fd = -1;
+			}
+		}
+	}
+};
+
+#endif
+
+#endif
@@ -0,0 +1,453 @@
+/**
+ * @file FileSink.h
+ * @brief This header file contains the class definition of a file sink which drains what a reader of a dynamic buffer
+ * reads to a file, with vectored writes of many buffer segments at once.
+ *
+ * @author Rakesh Kumar
+ */
+
+#pragma once
+
+#ifndef FILE_SINK_H
+#define FILE_SINK_H
+
+#include "DynamicBuffer.h"
+#include "IoUring.h"
+
+#if defined(__linux__)
+
+#include <fcntl.h>					// For open, O_DIRECT
+#include <unistd.h>					// For fsync, fdatasync, ftruncate, close
+#include <sys/uio.h>				// For pwritev, iovec
+#include <climits>					// For IOV_MAX
+#include <cerrno>					// For errno
+#include <cstring>					// For std::memcpy, std::memmove, std::strerror
+#include <cstddef>					// For std::byte
+#include <cstdint>					// For std::uint64_t
+#include <new>						// For std::align_val_t, the staging buffer of direct writes
+#include <atomic>					// For std::atomic
+#include <thread>					// For std::thread, the sink thread
+#include <vector>					// For std::vector
+#include <span>						// For std::span
+#include <memory>					// For std::unique_ptr
+#include <exception>				// For std::exception_ptr, passing the failure of the sink to `finish()` and `getError()`
+#include <stdexcept>				// For std::runtime_error
+#include <string>					// For std::string
+#include <chrono>					// For std::chrono::steady_clock, the cadence of the syncs
+#include <algorithm>				// For std::min
+#include <type_traits>				// For std::is_trivially_copyable_v
+
+/**
+* @brief When a file sink makes what it wrote durable (`fsync`). A sync is made when either threshold is reached, and
+* once more when the sink finishes if any is set.
+*/
+struct FileSyncPolicy {
+	unsigned long long everyBytes{ 0 };				// Sync after this many bytes written since the last sync (0 : never)
+	unsigned long long everyMillis{ 0 };			// Sync when this much time has passed since the last sync and
+	// something was written (0 : never)
+	bool dataOnly{ true };							// `fdatasync` instead of `fsync` (the metadata not needed to read
+	// the data back is not synced)
+};
+
+/**
+* @brief Drains the items read by a reader of a dynamic buffer (e.g. an attached reader, see
+* `DynBuffer::attachReader()`) to a file.
+*
+* A sink thread acquires views on up to `maxSegmentsPerWrite` consecutive buffer segments (`DynBuffer::acquireReadv()`)
+* and writes them with one vectored write (`pwritev`, or `IORING_OP_WRITEV` on io_uring) straight from their `items`
+* arrays. A write cut short is continued from where it stopped. The buffer segments are released once their items are
+* in the file.
+*
+* With `directIo` the file is opened with `O_DIRECT`: the items are gathered into a staging buffer aligned to
+* `DIRECT_IO_ALIGNMENT` and written by whole blocks, since the `items` arrays are aligned to a cache line only. The
+* last partial block is padded when the sink finishes and the file is truncated back to the size of the data.
+*
+* A failed write or sync stops the sink thread: `hasFailed()` tells it right away and `getError()` (or `finish()`)
+* gives the failure. The reader is not read anymore, it holds back the pruning of what it has not read until it is
+* detached (see `DynBuffer::detachReader()`) or read by someone else.
+*
+* @tparam T The type of the items of the buffer, trivially copyable (written as they are in memory).
+* @tparam Policy The policy of the buffer (see `BufferPolicy`).
+*/
+template <typename T = std::byte, typename Policy = BufferPolicy<>> class FileSink {
+
+	static_assert(std::is_trivially_copyable_v<T>, "The items written to a file must be trivially copyable");
+
+public:
+
+	// The alignment of the memory, the offsets and the lengths of direct (`O_DIRECT`) writes
+	static constexpr unsigned long long DIRECT_IO_ALIGNMENT = 4096;
+
+	// The size of the staging buffer of direct writes
+	static constexpr unsigned long long DIRECT_IO_STAGING_BYTES = 4ULL << 20;
+
+	/**
+	* @brief Constructor, creates (or truncates) the file at `path` and starts draining `pReader` to it.
+	*
+	* @param buffer The buffer read by `pReader`.
+	* @param pReader Pointer to the owner whose reads are drained to the file. It must not be read by anyone else
+	* while the sink is running.
+	* @param path The path of the file.
+	* @param syncPolicy When what was written is synced.
+	* @param directIo Bypass the page cache (`O_DIRECT`).
+	* @param maxSegmentsPerWrite The maximum number of buffer segments written by one vectored write.
+	* @param backend Where the writes are submitted to, `FILE_IO_BACKEND::THREAD_POOL` makes blocking calls on the
+	* sink thread.
+	*/
+	FileSink(
+		DynBuffer<T, Policy>& buffer,
+		BufferSegmentOwner* pReader,
+		const std::string& path,
+		FileSyncPolicy syncPolicy = FileSyncPolicy{},
+		bool directIo = false,
+		unsigned maxSegmentsPerWrite = 64,
+		FILE_IO_BACKEND backend = FILE_IO_BACKEND::AUTO
+	) : buffer(buffer), pReader(pReader), syncPolicy(syncPolicy), directIo(directIo),
+		maxSegmentsPerWrite(std::min<unsigned>(maxSegmentsPerWrite, IOV_MAX)) {
+		if (pReader == nullptr) {
+			throw std::runtime_error("ERR: OWNER NOT FOUND -- nullptr");
+		}
+		if (maxSegmentsPerWrite == 0) {
+			throw std::runtime_error("ERR: INVALID ARGUMENTS OF A FILE SINK -- 0 BUFFER SEGMENTS PER WRITE");
+		}
+		fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC | (directIo ? O_DIRECT : 0), 0644);
+		if (fd < 0) {
+			throw std::runtime_error("ERR: FAILED TO OPEN " + path + " -- " + std::strerror(errno));
+		}
+		if (directIo) {
+			staging = static_cast<std::byte*>(
+				::operator new(DIRECT_IO_STAGING_BYTES, std::align_val_t(DIRECT_IO_ALIGNMENT))
+			);
+		}
+		if (backend != FILE_IO_BACKEND::THREAD_POOL) {
+			try {
+				ring = std::make_unique<IoUring>(2);
+			}
+			catch (const std::runtime_error&) {
+				if (backend == FILE_IO_BACKEND::IO_URING) {
+					release();
+					throw;
+				}
+			}
+		}
+		lastSync = std::chrono::steady_clock::now();
+		sinkThread = std::thread([this]() { run(); });
+	}
+
+	/**
+	* @brief Destructor, finishes the sink (see `finish()`), a failure is not reported.
+	*/
+	~FileSink() {
+		try {
+			finish();
+		}
+		catch (...) {
+			// Nothing can be reported from here
+		}
+		release();
+	}
+
+	FileSink(const FileSink&) = delete;
+	FileSink& operator=(const FileSink&) = delete;
+
+	/**
+	* @brief Writes what the reader can read by now, syncs the file (if the sync policy asks for syncs) and stops the
+	* sink thread.
+	*
+	* @throws std::runtime_error if a write or a sync failed.
+	*/
+	void finish() {
+		finishing.store(true, std::memory_order_release);
+		if (sinkThread.joinable()) {
+			sinkThread.join();
+		}
+		if (hasFailed()) {
+			std::rethrow_exception(failure);
+		}
+	}
+
+	/**
+	* @brief Check if a write or a sync failed, the sink thread has stopped then.
+	*/
+	bool hasFailed() const {
+		return failed.load(std::memory_order_acquire);
+	}
+
+	/**
+	* @brief Get the failure of the sink thread, nullptr if it has not failed.
+	*/
+	std::exception_ptr getError() const {
+		return hasFailed() ? failure : nullptr;
+	}
+
+	/**
+	* @brief Get the number of bytes written to the file so far.
+	*/
+	unsigned long long getBytesWritten() const {
+		return bytesWritten.load(std::memory_order_acquire);
+	}
+
+	/**
+	* @brief Get the number of write calls (system calls or io_uring submissions) made so far.
+	*/
+	unsigned long long getWriteCalls() const {
+		return writeCalls.load(std::memory_order_acquire);
+	}
+
+	/**
+	* @brief Get the number of syncs made so far.
+	*/
+	unsigned long long getSyncCalls() const {
+		return syncCalls.load(std::memory_order_acquire);
+	}
+
+	/**
+	* @brief Get the backend the writes are submitted to, `FILE_IO_BACKEND::IO_URING` or `FILE_IO_BACKEND::THREAD_POOL`.
+	*/
+	FILE_IO_BACKEND getBackend() const {
+		return ring ? FILE_IO_BACKEND::IO_URING : FILE_IO_BACKEND::THREAD_POOL;
+	}
+
+private:
+
+	DynBuffer<T, Policy>& buffer;						// The buffer read by `pReader`
+	BufferSegmentOwner* pReader{ nullptr };				// The owner whose reads are drained to the file
+	FileSyncPolicy syncPolicy;							// When what was written is synced
+	bool directIo{ false };								// The file is written with `O_DIRECT`
+	unsigned maxSegmentsPerWrite{ 0 };					// The maximum number of buffer segments in a vectored write
+	int fd{ -1 };										// The file descriptor
+	std::unique_ptr<IoUring> ring;						// The io_uring the writes are submitted to, if available
+	std::byte* staging{ nullptr };						// The staging buffer of direct writes (aligned)
+	unsigned long long stagedBytes{ 0 };				// The bytes in the staging buffer
+	unsigned long long fileOffset{ 0 };					// The offset of the next write
+	unsigned long long unsyncedBytes{ 0 };				// The bytes written since the last sync
+	std::chrono::steady_clock::time_point lastSync;		// The time of the last sync
+	std::thread sinkThread;
+	std::atomic<bool> finishing{ false };
+	std::atomic<unsigned long long> bytesWritten{ 0 };
+	std::atomic<unsigned long long> writeCalls{ 0 };
+	std::atomic<unsigned long long> syncCalls{ 0 };
+	std::exception_ptr failure;							// The failure of the sink thread, rethrown by `finish()`
+	std::atomic<bool> failed{ false };					// `failure` is set, it is not changed anymore
+
+	/**
+	* @brief The loop of the sink thread.
+	*/
+	void run() {
+		std::vector<std::span<const T>> views;
+		std::vector<iovec> iovecs;
+		views.reserve(maxSegmentsPerWrite);
+		iovecs.reserve(maxSegmentsPerWrite);
+		try {
+			while (true) {
+				// Loaded before the views so that whatever was published before `finish()` is written
+				bool lastPass = finishing.load(std::memory_order_acquire);
+				unsigned long long items = buffer.acquireReadv(pReader, views, maxSegmentsPerWrite, ~0ULL);
+				if (items == 0) {
+					if (lastPass) {
+						break;
+					}
+					buffer.waitForItems(pReader, std::chrono::milliseconds(10));
+					continue;
+				}
+				try {
+					if (directIo) {
+						stage(views);
+					}
+					else {
+						iovecs.clear();
+						for (const std::span<const T>& view : views) {
+							iovecs.push_back(iovec{ const_cast<T*>(view.data()), view.size_bytes() });
+						}
+						writeAll(iovecs.data(), iovecs.size());
+					}
+				}
+				catch (...) {
+					buffer.releaseReadv(pReader, 0);
+					throw;
+				}
+				buffer.releaseReadv(pReader, items);
+				syncIfDue(false);
+			}
+			if (directIo) {
+				flushStaging(true);
+			}
+			syncIfDue(true);
+		}
+		catch (...) {
+			failure = std::current_exception();
+			failed.store(true, std::memory_order_release);
+		}
+	}
+
+	/**
+	* @brief Copies the views to the staging buffer, writing the staging buffer out by whole blocks as it fills up.
+	*/
+	void stage(const std::vector<std::span<const T>>& views) {
+		for (const std::span<const T>& view : views) {
+			const std::byte* source = reinterpret_cast<const std::byte*>(view.data());
+			unsigned long long length = view.size_bytes();
+			while (length > 0) {
+				unsigned long long chunk = std::min(length, DIRECT_IO_STAGING_BYTES - stagedBytes);
+				std::memcpy(staging + stagedBytes, source, chunk);
+				stagedBytes += chunk;
+				source += chunk;
+				length -= chunk;
+				if (stagedBytes == DIRECT_IO_STAGING_BYTES) {
+					flushStaging(false);
+				}
+			}
+		}
+		flushStaging(false);
+	}
+
+	/**
+	* @brief Writes the whole blocks of the staging buffer and keeps the rest for the next write. The last partial
+	* block is padded and written too if `final`, then the file is truncated to the size of the data.
+	*/
+	void flushStaging(bool final) {
+		unsigned long long blocks = stagedBytes / DIRECT_IO_ALIGNMENT * DIRECT_IO_ALIGNMENT;
+		if (final && blocks < stagedBytes) {
+			unsigned long long padded = blocks + DIRECT_IO_ALIGNMENT;
+			std::memset(staging + stagedBytes, 0, padded - stagedBytes);
+			iovec whole{ staging, padded };
+			unsigned long long dataEnd = fileOffset + stagedBytes;
+			writeAll(&whole, 1);
+			if (::ftruncate(fd, (off_t)dataEnd) != 0) {
+				throw std::runtime_error(std::string("ERR: FAILED TO TRUNCATE THE FILE -- ") + std::strerror(errno));
+			}
+			// The padding is not data
+			bytesWritten.fetch_sub(padded - stagedBytes, std::memory_order_acq_rel);
+			fileOffset = dataEnd;
+			stagedBytes = 0;
+			return;
+		}
+		if (blocks == 0) {
+			return;
+		}
+		iovec whole{ staging, blocks };
+		writeAll(&whole, 1);
+		std::memmove(staging, staging + blocks, stagedBytes - blocks);
+		stagedBytes -= blocks;
+	}
+
+	/**
+	* @brief Writes the buffers of `iovecs` at the end of the file, continuing the writes cut short.
+	*/
+	void writeAll(iovec* iovecs, unsigned long long count) {
+		while (count > 0) {
+			long long written = writev(iovecs, count);
+			writeCalls.fetch_add(1, std::memory_order_relaxed);
+			if (written == -EINTR || written == -EAGAIN) {
+				continue;
+			}
+			if (written < 0) {
+				throw std::runtime_error(
+					"ERR: WRITE AT " + std::to_string(fileOffset) + " FAILED -- " + std::strerror((int)-written)
+				);
+			}
+			if (written == 0) {
+				throw std::runtime_error("ERR: WRITE AT " + std::to_string(fileOffset) + " FAILED -- NOTHING WRITTEN");
+			}
+			fileOffset += (unsigned long long)written;
+			unsyncedBytes += (unsigned long long)written;
+			bytesWritten.fetch_add((unsigned long long)written, std::memory_order_acq_rel);
+			// Skip what was written
+			unsigned long long left = (unsigned long long)written;
+			while (count > 0 && left >= iovecs->iov_len) {
+				left -= iovecs->iov_len;
+				++iovecs;
+				--count;
+			}
+			if (count > 0) {
+				iovecs->iov_base = static_cast<std::byte*>(iovecs->iov_base) + left;
+				iovecs->iov_len -= left;
+			}
+		}
+	}
+
+	/**
+	* @brief Makes one vectored write at `fileOffset`.
+	*
+	* @return The number of bytes written, a negated `errno` on failure.
+	*/
+	long long writev(const iovec* iovecs, unsigned long long count) {
+		if (ring) {
+			if (!(ring->prepare(IORING_OP_WRITEV, fd, iovecs, (unsigned)count, fileOffset, 0))) {
+				throw std::runtime_error("ERR: IO_URING SUBMISSION QUEUE FULL");
+			}
+			return complete();
+		}
+		ssize_t written = ::pwritev(fd, iovecs, (int)count, (off_t)fileOffset);
+		return written < 0 ? -(long long)errno : (long long)written;
+	}
+
+	/**
+	* @brief Syncs the file if the sync policy asks for it now, or at the end if `final`.
+	*/
+	void syncIfDue(bool final) {
+		if (syncPolicy.everyBytes == 0 && syncPolicy.everyMillis == 0) {
+			return;
+		}
+		if (unsyncedBytes == 0 && !final) {
+			return;
+		}
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		bool due = final ||
+			(syncPolicy.everyBytes != 0 && unsyncedBytes >= syncPolicy.everyBytes) ||
+			(syncPolicy.everyMillis != 0 && now - lastSync >= std::chrono::milliseconds(syncPolicy.everyMillis));
+		if (!due) {
+			return;
+		}
+		long long result{ 0 };
+		if (ring) {
+			if (!(ring->prepare(IORING_OP_FSYNC, fd, nullptr, 0, 0, 0, syncPolicy.dataOnly ? IORING_FSYNC_DATASYNC : 0))) {
+				throw std::runtime_error("ERR: IO_URING SUBMISSION QUEUE FULL");
+			}
+			result = complete();
+		}
+		else {
+			result = (syncPolicy.dataOnly ? ::fdatasync(fd) : ::fsync(fd)) == 0 ? 0 : -(long long)errno;
+		}
+		if (result < 0) {
+			throw std::runtime_error(std::string("ERR: FAILED TO SYNC THE FILE -- ") + std::strerror((int)-result));
+		}
+		syncCalls.fetch_add(1, std::memory_order_relaxed);
+		unsyncedBytes = 0;
+		lastSync = now;
+	}
+
+	/**
+	* @brief Submits the request prepared on the ring and waits for its completion.
+	*
+	* @return The result of the request.
+	*/
+	long long complete() {
+		ring->submit();
+		std::uint64_t userData{ 0 };
+		int result{ 0 };
+		while (!(ring->popCompletion(userData, result))) {
+			ring->waitCompletion();
+		}
+		return result;
+	}
+
+	/**
+	* @brief Closes the file and frees the staging buffer.
+	*/
+	void release() {
+		ring.reset();
+		if (staging != nullptr) {
+			::operator delete(staging, std::align_val_t(DIRECT_IO_ALIGNMENT));
+			staging = nullptr;
+		}
+		if (fd >= 0) {
+			::close(fd);
+			fd = -1;
+		}
+	}
+};
+
+#endif
+
+#endif
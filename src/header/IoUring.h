@@ -0,0 +1,254 @@
+/**
+ * @file IoUring.h
+ * @brief This header file contains the class definition of a minimal io_uring submission/completion ring (set up
+ * through the raw system calls, without liburing) used by the asynchronous file engines of the dynamic buffer.
+ *
+ * @author Rakesh Kumar
+ */
+
+#pragma once
+
+#ifndef IO_URING_H
+#define IO_URING_H
+
+/**
+ * @brief The backend an asynchronous file engine submits its reads and writes to.
+ */
+enum FILE_IO_BACKEND {
+	AUTO,			// io_uring when the kernel provides it, the thread pool otherwise
+	IO_URING,		// io_uring, the engine fails if it is not available
+	THREAD_POOL		// Blocking `pread` / `pwrite` calls on a pool of threads
+};
+
+#if defined(__linux__)
+
+#include <linux/io_uring.h>			// For io_uring_params, io_uring_sqe, io_uring_cqe, IORING_*
+#include <sys/mman.h>				// For mmap, munmap (the rings)
+#include <sys/syscall.h>			// For SYS_io_uring_setup, SYS_io_uring_enter
+#include <unistd.h>					// For syscall, close
+#include <atomic>					// For std::atomic_ref, the heads and tails shared with the kernel
+#include <cerrno>					// For errno
+#include <cstring>					// For std::memset, std::strerror
+#include <cstdint>					// For std::uint8_t, std::uint64_t
+#include <stdexcept>				// For std::runtime_error
+#include <string>					// For std::string
+#include <algorithm>				// For std::max
+
+/**
+* @brief An io_uring instance: a submission queue the requests are prepared in and a completion queue their results
+* are taken from.
+*
+* It is driven by one thread at a time (the engine that owns it). The requests are passed as they are to the kernel,
+* `userData` identifies a request in its completion.
+*/
+class IoUring {
+
+public:
+
+	/**
+	* @brief Constructor, sets up a ring of at least `entries` submission entries.
+	*
+	* @throws std::runtime_error if io_uring is not available (old kernel, disabled by the system or a sandbox).
+	*/
+	explicit IoUring(unsigned entries) {
+		io_uring_params params;
+		std::memset(&params, 0, sizeof(params));
+		ringFd = (int)::syscall(SYS_io_uring_setup, entries, &params);
+		if (ringFd < 0) {
+			throw std::runtime_error(std::string("ERR: IO_URING NOT AVAILABLE -- ") + std::strerror(errno));
+		}
+		sqRingBytes = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+		cqRingBytes = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+		bool singleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+		if (singleMmap) {
+			sqRingBytes = cqRingBytes = std::max(sqRingBytes, cqRingBytes);
+		}
+		sqRing = map(sqRingBytes, IORING_OFF_SQ_RING);
+		cqRing = singleMmap ? sqRing : map(cqRingBytes, IORING_OFF_CQ_RING);
+		sqesBytes = params.sq_entries * sizeof(io_uring_sqe);
+		sqes = static_cast<io_uring_sqe*>(map(sqesBytes, IORING_OFF_SQES));
+
+		sqHead = at<unsigned>(sqRing, params.sq_off.head);
+		sqTail = at<unsigned>(sqRing, params.sq_off.tail);
+		sqMask = *at<unsigned>(sqRing, params.sq_off.ring_mask);
+		sqArray = at<unsigned>(sqRing, params.sq_off.array);
+		sqEntries = params.sq_entries;
+		cqHead = at<unsigned>(cqRing, params.cq_off.head);
+		cqTail = at<unsigned>(cqRing, params.cq_off.tail);
+		cqMask = *at<unsigned>(cqRing, params.cq_off.ring_mask);
+		cqes = at<io_uring_cqe>(cqRing, params.cq_off.cqes);
+	}
+
+	/**
+	* @brief Destructor, tears the rings down. The requests still in flight are cancelled by the kernel.
+	*/
+	~IoUring() {
+		release();
+	}
+
+	IoUring(const IoUring&) = delete;
+	IoUring& operator=(const IoUring&) = delete;
+
+	/**
+	* @brief Prepares a request in the submission queue, it is passed to the kernel by `submit()`.
+	*
+	* @param opcode The operation (`IORING_OP_READ`, `IORING_OP_WRITEV`, ...).
+	* @param fd The file descriptor.
+	* @param address The buffer (or the `iovec` array of the vectored operations).
+	* @param length The number of bytes (or of `iovec`s).
+	* @param offset The offset in the file, `(std::uint64_t)-1` for the current file position.
+	* @param userData Identifies the request in its completion.
+	* @param rwFlags The flags of the operation (e.g. `IORING_FSYNC_DATASYNC`).
+	* @return false if the submission queue is full.
+	*/
+	bool prepare(
+		std::uint8_t opcode,
+		int fd,
+		const void* address,
+		unsigned length,
+		std::uint64_t offset,
+		std::uint64_t userData,
+		unsigned rwFlags = 0
+	) {
+		unsigned tail = *sqTail;		// Only written by this thread
+		if (tail - std::atomic_ref<unsigned>(*sqHead).load(std::memory_order_acquire) == sqEntries) {
+			return false;
+		}
+		unsigned index = tail & sqMask;
+		io_uring_sqe* sqe = &sqes[index];
+		std::memset(sqe, 0, sizeof(io_uring_sqe));
+		sqe->opcode = opcode;
+		sqe->fd = fd;
+		sqe->addr = (std::uint64_t)address;
+		sqe->len = length;
+		sqe->off = offset;
+		sqe->rw_flags = (int)rwFlags;
+		sqe->user_data = userData;
+		sqArray[index] = index;
+		std::atomic_ref<unsigned>(*sqTail).store(tail + 1, std::memory_order_release);
+		++prepared;
+		return true;
+	}
+
+	/**
+	* @brief Passes the prepared requests to the kernel.
+	*/
+	void submit() {
+		while (prepared > 0) {
+			int submitted = enter(prepared, 0, 0);
+			if (submitted < 0) {
+				throw std::runtime_error(std::string("ERR: IO_URING SUBMISSION FAILED -- ") + std::strerror(-submitted));
+			}
+			prepared -= (unsigned)submitted;
+		}
+	}
+
+	/**
+	* @brief Takes the oldest completion from the completion queue without waiting.
+	*
+	* @param userData The `userData` of the completed request.
+	* @param result The result of the request, a negated `errno` on failure.
+	* @return false if no request has completed.
+	*/
+	bool popCompletion(std::uint64_t& userData, int& result) {
+		unsigned head = *cqHead;		// Only written by this thread
+		if (head == std::atomic_ref<unsigned>(*cqTail).load(std::memory_order_acquire)) {
+			return false;
+		}
+		const io_uring_cqe& cqe = cqes[head & cqMask];
+		userData = cqe.user_data;
+		result = cqe.res;
+		std::atomic_ref<unsigned>(*cqHead).store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	* @brief Blocks until a request has completed.
+	*/
+	void waitCompletion() {
+		int result = enter(0, 1, IORING_ENTER_GETEVENTS);
+		if (result < 0) {
+			throw std::runtime_error(std::string("ERR: IO_URING WAIT FAILED -- ") + std::strerror(-result));
+		}
+	}
+
+private:
+
+	int ringFd{ -1 };							// The file descriptor of the ring
+	void* sqRing{ nullptr };					// The mapping of the submission queue ring
+	void* cqRing{ nullptr };					// The mapping of the completion queue ring (may be `sqRing`)
+	io_uring_sqe* sqes{ nullptr };				// The submission queue entries
+	unsigned long long sqRingBytes{ 0 };		// The length of the mapping of the submission queue ring
+	unsigned long long cqRingBytes{ 0 };		// The length of the mapping of the completion queue ring
+	unsigned long long sqesBytes{ 0 };			// The length of the mapping of the submission queue entries
+	unsigned* sqHead{ nullptr };				// Advanced by the kernel as it consumes the submissions
+	unsigned* sqTail{ nullptr };				// Advanced by this ring as it prepares the submissions
+	unsigned sqMask{ 0 };
+	unsigned* sqArray{ nullptr };				// The indices of the prepared submission queue entries
+	unsigned sqEntries{ 0 };
+	unsigned* cqHead{ nullptr };				// Advanced by this ring as it takes the completions
+	unsigned* cqTail{ nullptr };				// Advanced by the kernel as it posts the completions
+	unsigned cqMask{ 0 };
+	io_uring_cqe* cqes{ nullptr };				// The completion queue entries
+	unsigned prepared{ 0 };						// The requests prepared but not passed to the kernel yet
+
+	/**
+	* @brief Maps a region of the ring, the ring is torn down if it fails.
+	*/
+	void* map(unsigned long long bytes, unsigned long long offset) {
+		void* region = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, (off_t)offset);
+		if (region == MAP_FAILED) {
+			int error = errno;
+			release();
+			throw std::runtime_error(std::string("ERR: IO_URING NOT AVAILABLE -- ") + std::strerror(error));
+		}
+		return region;
+	}
+
+	/**
+	* @brief Get a pointer to the field at `offset` in a region of the ring.
+	*/
+	template <typename Field> static Field* at(void* region, unsigned offset) {
+		return reinterpret_cast<Field*>(static_cast<char*>(region) + offset);
+	}
+
+	/**
+	* @brief Calls `io_uring_enter`, retrying when it is interrupted by a signal.
+	*
+	* @return The number of requests submitted or a negated `errno`.
+	*/
+	int enter(unsigned toSubmit, unsigned minComplete, unsigned flags) {
+		while (true) {
+			int result = (int)::syscall(SYS_io_uring_enter, ringFd, toSubmit, minComplete, flags, nullptr, 0);
+			if (result >= 0 || errno != EINTR) {
+				return result < 0 ? -errno : result;
+			}
+		}
+	}
+
+	/**
+	* @brief Unmaps the rings and closes the ring's file descriptor.
+	*/
+	void release() {
+		if (sqes != nullptr) {
+			::munmap(sqes, sqesBytes);
+			sqes = nullptr;
+		}
+		if (cqRing != nullptr && cqRing != sqRing) {
+			::munmap(cqRing, cqRingBytes);
+		}
+		cqRing = nullptr;
+		if (sqRing != nullptr) {
+			::munmap(sqRing, sqRingBytes);
+			sqRing = nullptr;
+		}
+		if (ringFd >= 0) {
+			::close(ringFd);
+			ringFd = -1;
+		}
+	}
+};
+
+#endif
+
+#endif
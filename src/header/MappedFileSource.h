@@ -0,0 +1,226 @@
+/**
+ * @file MappedFileSource.h
+ * @brief This header file contains the class definition of a file source which streams a file through a dynamic
+ * buffer by mapping its pages into the buffer segments instead of copying them.
+ *
+ * @author Rakesh Kumar
+ */
+
+#pragma once
+
+#ifndef MAPPED_FILE_SOURCE_H
+#define MAPPED_FILE_SOURCE_H
+
+#include "DynamicBuffer.h"
+
+#if defined(__linux__)
+
+#include <sys/mman.h>				// For mmap, madvise, munmap
+#include <sys/stat.h>				// For fstat
+#include <fcntl.h>					// For open
+#include <unistd.h>					// For close, sysconf
+#include <cerrno>					// For errno
+#include <cstring>					// For std::strerror
+#include <memory>					// For std::shared_ptr
+#include <numeric>					// For std::lcm
+#include <algorithm>				// For std::min
+#include <mutex>					// For std::mutex, the readahead state shared by the readers
+#include <functional>				// For std::function, reading ahead as the readers get to a window
+#include <string>					// For std::string
+#include <stdexcept>				// For std::runtime_error
+#include <type_traits>				// For std::is_trivially_copyable_v
+
+/**
+* @brief Streams a file through a dynamic buffer without copying it: the file is mapped read-only and every window
+* of it is appended to the buffer as a read-only buffer segment (see `DynBuffer::adoptItems()`). Readers read the
+* windows like any other buffer segment of the writer, straight from the page cache.
+*
+* The pages are read ahead of the readers with `madvise()`: the whole mapping is marked `MADV_SEQUENTIAL` and the
+* first `readaheadWindows` windows `MADV_WILLNEED`. Each time the first reader gets to a window, the window
+* `readaheadWindows` after it is marked `MADV_WILLNEED`. Each time a window has been read and is pruned from the buffer
+* it is unmapped, so the pages in use follow the readers.
+*
+* The items are the bytes of the file seen as `T`, a trailing part of the file shorter than `sizeof(T)` is not read.
+* The mapping outlives the source, the windows still in the buffer are unmapped by the buffer.
+*
+* @tparam T The type of the items of the buffer, trivially copyable.
+* @tparam Policy The policy of the buffer (see `BufferPolicy`), of a variable buffer segment capacity.
+*/
+template <typename T = std::byte, typename Policy = BufferPolicy<>> class MappedFileSource {
+
+	static_assert(std::is_trivially_copyable_v<T>, "The items of a mapped file must be trivially copyable");
+
+public:
+
+	/**
+	* @brief Constructor, maps the file at `path`.
+	*
+	* @param buffer The buffer the file is streamed through.
+	* @param pOwner Pointer to the owner with write access the windows are appended for.
+	* @param path The path of the file.
+	* @param windowBytes The size of a window (a buffer segment) in bytes, rounded up to whole pages and items.
+	* @param readaheadWindows The number of windows read ahead of the readers.
+	*/
+	MappedFileSource(
+		DynBuffer<T, Policy>& buffer,
+		BufferSegmentOwner* pOwner,
+		const std::string& path,
+		unsigned long long windowBytes = 8ULL << 20,
+		unsigned long long readaheadWindows = 2
+	) : buffer(buffer), pOwner(pOwner), mapping(std::make_shared<Mapping>()) {
+		if (pOwner == nullptr) {
+			throw std::runtime_error("ERR: OWNER NOT FOUND -- nullptr");
+		}
+		if (windowBytes == 0) {
+			throw std::runtime_error("ERR: INVALID WINDOW SIZE OF A MAPPED FILE -- 0 BYTES");
+		}
+		int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (fd < 0) {
+			throw std::runtime_error("ERR: FAILED TO OPEN " + path + " -- " + std::strerror(errno));
+		}
+		struct stat status {};
+		if (::fstat(fd, &status) != 0) {
+			int error = errno;
+			::close(fd);
+			throw std::runtime_error("ERR: FAILED TO STAT " + path + " -- " + std::strerror(error));
+		}
+		unsigned long long fileBytes = (unsigned long long)status.st_size;
+		mapping->length = fileBytes - fileBytes % sizeof(T);
+		if (mapping->length > 0) {
+			void* base = ::mmap(nullptr, mapping->length, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (base == MAP_FAILED) {
+				int error = errno;
+				::close(fd);
+				throw std::runtime_error("ERR: FAILED TO MAP " + path + " -- " + std::strerror(error));
+			}
+			mapping->base = static_cast<std::byte*>(base);
+		}
+		// The mapping keeps the pages of the file, the descriptor is not needed anymore
+		::close(fd);
+
+		// A window starts on a page and holds whole items so that every buffer segment is unmapped on its own
+		unsigned long long pageBytes = (unsigned long long)::sysconf(_SC_PAGESIZE);
+		unsigned long long unit = std::lcm(pageBytes, (unsigned long long)sizeof(T));
+		mapping->windowBytes = (windowBytes + unit - 1) / unit * unit;
+		mapping->readaheadWindows = readaheadWindows;
+		if (mapping->base != nullptr) {
+			::madvise(mapping->base, mapping->length, MADV_SEQUENTIAL);
+			for (unsigned long long window = 0; window < readaheadWindows; ++window) {
+				mapping->willNeed(window);
+			}
+		}
+	}
+
+	/**
+	* @brief Destructor, unmaps the windows which were not appended to the buffer.
+	*/
+	~MappedFileSource() {
+		if (mapping->base != nullptr && nextOffset < mapping->length) {
+			::munmap(mapping->base + nextOffset, mapping->length - nextOffset);
+		}
+	}
+
+	MappedFileSource(const MappedFileSource&) = delete;
+	MappedFileSource& operator=(const MappedFileSource&) = delete;
+
+	/**
+	* @brief Appends the next window of the file to the buffer.
+	*
+	* @return false if the whole file has been appended already.
+	*/
+	bool pump() {
+		if (exhausted()) {
+			return false;
+		}
+		unsigned long long offset = nextOffset;
+		unsigned long long bytes = std::min(mapping->windowBytes, mapping->length - offset);
+		std::shared_ptr<Mapping> pMapping = mapping;
+		std::function<void()> reached;
+		if (mapping->readaheadWindows > 0) {
+			reached = [pMapping, offset]() {
+				pMapping->willNeed(offset / pMapping->windowBytes + pMapping->readaheadWindows);
+			};
+		}
+		buffer.adoptItems(
+			pOwner,
+			reinterpret_cast<T*>(mapping->base + offset),
+			bytes / sizeof(T),
+			[pMapping, offset, bytes](T*, unsigned long long) { ::munmap(pMapping->base + offset, bytes); },
+			std::move(reached)
+		);
+		nextOffset += bytes;
+		return true;
+	}
+
+	/**
+	* @brief Appends every window of the file not appended yet to the buffer. The pages are still read lazily, as the
+	* readers get to them.
+	*
+	* @return The number of windows appended.
+	*/
+	unsigned long long pumpAll() {
+		unsigned long long windows = 0;
+		while (pump()) {
+			++windows;
+		}
+		return windows;
+	}
+
+	/**
+	* @brief Check if the whole file has been appended to the buffer.
+	*/
+	bool exhausted() const {
+		return nextOffset >= mapping->length;
+	}
+
+	/**
+	* @brief Get the number of bytes of the file streamed through the buffer (whole items).
+	*/
+	unsigned long long length() const {
+		return mapping->length;
+	}
+
+	/**
+	* @brief Get the size of a window in bytes.
+	*/
+	unsigned long long getWindowBytes() const {
+		return mapping->windowBytes;
+	}
+
+private:
+
+	/**
+	* @brief The mapping of the file, shared by the source and the windows in the buffer which unmap it piece by piece.
+	*/
+	struct Mapping {
+		std::byte* base{ nullptr };						// The start of the mapping
+		unsigned long long length{ 0 };					// The length of the mapping in bytes
+		unsigned long long windowBytes{ 0 };			// The size of a window in bytes (whole pages)
+		unsigned long long readaheadWindows{ 0 };		// The number of windows read ahead of the readers
+		unsigned long long advisedWindows{ 0 };			// The windows marked `MADV_WILLNEED` so far
+		std::mutex mutex;								// Guards `advisedWindows`, advanced by the readers
+
+		/**
+		* @brief Marks `window` and the windows before it not marked yet `MADV_WILLNEED`.
+		*/
+		void willNeed(unsigned long long window) {
+			std::lock_guard<std::mutex> lock(mutex);
+			for (; advisedWindows <= window; ++advisedWindows) {
+				unsigned long long offset = advisedWindows * windowBytes;
+				if (offset >= length) {
+					return;
+				}
+				::madvise(base + offset, std::min(windowBytes, length - offset), MADV_WILLNEED);
+			}
+		}
+	};
+
+	DynBuffer<T, Policy>& buffer;						// The buffer the file is streamed through
+	BufferSegmentOwner* pOwner{ nullptr };				// The writer the windows are appended for
+	std::shared_ptr<Mapping> mapping;					// The mapping of the file
+	unsigned long long nextOffset{ 0 };					// The offset of the next window to be appended
+};
+
+#endif
+
+#endif
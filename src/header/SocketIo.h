@@ -0,0 +1,162 @@
+/**
+ * @file SocketIo.h
+ * @brief This header file contains the functions which receive from and send to sockets (or any other stream file
+ * descriptor) straight from the buffer segments of a byte stream of a dynamic buffer, with scatter-gather calls.
+ *
+ * @author Rakesh Kumar
+ */
+
+#pragma once
+
+#ifndef SOCKET_IO_H
+#define SOCKET_IO_H
+
+#include "DynamicBuffer.h"
+
+#if defined(__linux__)
+
+#include <sys/socket.h>				// For sendmsg, msghdr, MSG_NOSIGNAL
+#include <sys/uio.h>				// For readv, writev, iovec
+#include <climits>					// For IOV_MAX
+#include <cerrno>					// For errno
+#include <cstring>					// For std::strerror
+#include <cstddef>					// For std::byte
+#include <optional>					// For std::optional, calls which would block
+#include <span>						// For std::span
+#include <vector>					// For std::vector
+#include <stdexcept>				// For std::runtime_error
+#include <string>					// For std::string
+#include <algorithm>				// For std::min
+
+/**
+* @brief Receives from `fd` straight into the byte stream of `pOwner` with one scattered read (`readv`).
+*
+* The bytes land in the room left at the end of the owner's last buffer segment (`DynBuffer::reserveAvailable()`)
+* and, when that is less than `maxBytes`, in a new buffer segment (`DynBuffer::reserveSegment()`) which follows it.
+* What was received is published right away, the unused room is given back.
+*
+* @param fd The file descriptor (a socket, a pipe, ...).
+* @param buffer The buffer.
+* @param pOwner Pointer to the owner with write access the bytes are received for.
+* @param maxBytes The maximum number of bytes received.
+* @return The number of bytes received, 0 at the end of the stream only, no value if `fd` is non-blocking and nothing
+* can be received now.
+* @throws BufferOverflowError if there is no room for a single byte: the last buffer segment is full and the memory
+* budget is exhausted with an overflow policy dropping the items (nothing is read from `fd`).
+* @throws std::runtime_error if `maxBytes` is 0 or the read fails.
+*/
+template <typename Policy>
+std::optional<unsigned long long> recvInto(
+	int fd,
+	DynBuffer<std::byte, Policy>& buffer,
+	BufferSegmentOwner* pOwner,
+	unsigned long long maxBytes = 64ULL << 10
+) {
+	if (maxBytes == 0) {
+		throw std::runtime_error("ERR: RECEIVE FAILED -- 0 BYTES");
+	}
+	std::span<std::byte> tail = buffer.reserveAvailable(pOwner, maxBytes);
+	BufferSegment<std::byte>* next{ nullptr };
+	iovec iovecs[2];
+	int count = 0;
+	if (!(tail.empty())) {
+		iovecs[count++] = iovec{ tail.data(), tail.size() };
+	}
+	if (tail.size() < maxBytes) {
+		try {
+			// Of the full size, the next calls receive into the rest of it
+			next = buffer.reserveSegment(maxBytes);
+		}
+		catch (...) {
+			buffer.commit(pOwner, 0);
+			throw;
+		}
+		if (next != nullptr) {
+			iovecs[count++] = iovec{ next->getItems(), maxBytes - tail.size() };
+		}
+	}
+	if (count == 0) {
+		// Over the memory budget and nothing left in the last buffer segment, not to be taken for the end of the stream
+		throw BufferOverflowError("ERR: RECEIVE FAILED -- NO ROOM WITHIN THE MEMORY BUDGET");
+	}
+	ssize_t received{ 0 };
+	do {
+		received = ::readv(fd, iovecs, count);
+	} while (received < 0 && errno == EINTR);
+	int error = errno;
+	unsigned long long bytes = received < 0 ? 0 : (unsigned long long)received;
+	unsigned long long inTail = std::min(bytes, (unsigned long long)tail.size());
+	buffer.commit(pOwner, inTail);
+	if (next != nullptr) {
+		buffer.commitSegment(pOwner, next, bytes - inTail);
+	}
+	if (received < 0) {
+		if (error == EAGAIN || error == EWOULDBLOCK) {
+			return std::nullopt;
+		}
+		throw std::runtime_error(std::string("ERR: RECEIVE FAILED -- ") + std::strerror(error));
+	}
+	return bytes;
+}
+
+/**
+* @brief Sends what `pReader` can read from `fd` with one gathered write across up to `maxSegments` buffer segments
+* (`sendmsg` for sockets, `writev` for other file descriptors).
+*
+* The reader's cursor is advanced by exactly the number of bytes sent, a partial send leaves the rest to be sent by the
+* next call. `SIGPIPE` is not raised when the peer of a socket has gone.
+*
+* @param fd The file descriptor (a socket, a pipe, ...).
+* @param buffer The buffer.
+* @param pReader Pointer to the owner whose readable bytes are sent.
+* @param maxSegments The maximum number of buffer segments sent by one call.
+* @param maxBytes The maximum number of bytes sent by one call.
+* @return The number of bytes sent, 0 if there was nothing to be sent, no value if `fd` is non-blocking and nothing
+* can be sent now.
+* @throws std::runtime_error if the write fails.
+*/
+template <typename Policy>
+std::optional<unsigned long long> sendFrom(
+	int fd,
+	DynBuffer<std::byte, Policy>& buffer,
+	BufferSegmentOwner* pReader,
+	unsigned long long maxSegments = 64,
+	unsigned long long maxBytes = ~0ULL
+) {
+	// Reused across the calls of a thread, the views of the reader are released before returning
+	thread_local std::vector<std::span<const std::byte>> views;
+	thread_local std::vector<iovec> iovecs;
+	unsigned long long available = buffer.acquireReadv(
+		pReader, views, std::min<unsigned long long>(maxSegments, IOV_MAX), maxBytes
+	);
+	if (available == 0) {
+		return 0ULL;
+	}
+	iovecs.clear();
+	for (const std::span<const std::byte>& view : views) {
+		iovecs.push_back(iovec{ const_cast<std::byte*>(view.data()), view.size() });
+	}
+	msghdr message{};
+	message.msg_iov = iovecs.data();
+	message.msg_iovlen = iovecs.size();
+	ssize_t sent{ 0 };
+	do {
+		sent = ::sendmsg(fd, &message, MSG_NOSIGNAL);
+		if (sent < 0 && errno == ENOTSOCK) {
+			sent = ::writev(fd, iovecs.data(), (int)iovecs.size());
+		}
+	} while (sent < 0 && errno == EINTR);
+	int error = errno;
+	buffer.releaseReadv(pReader, sent < 0 ? 0 : (unsigned long long)sent);
+	if (sent < 0) {
+		if (error == EAGAIN || error == EWOULDBLOCK) {
+			return std::nullopt;
+		}
+		throw std::runtime_error(std::string("ERR: SEND FAILED -- ") + std::strerror(error));
+	}
+	return (unsigned long long)sent;
+}
+
+#endif
+
+#endif
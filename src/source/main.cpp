@@ -5,10 +5,13 @@
  * @author Rakesh Kumar
  */
 
+#define NOMINMAX                    // Keep std::min and std::max usable
 #include <Windows.h>
 #include <iostream>
 #include "../header/DynamicBuffer.h"
 #include <chrono>
+#include <vector>
+#include <span>
 
 /**
 * @brief The entry point of the application.
@@ -39,8 +42,22 @@ int main() {
     for (unsigned long long i = 1; i <= 10035; i++) {
         dynBuffer->write(i, owner);
     }
+    auto writerTEnqueued = std::chrono::steady_clock::now();
+    // Wait for the owner's writer worker to write every submitted item
+    dynBuffer->flush(owner);
     auto writerTEnd = std::chrono::steady_clock::now();
 
+    // BULK WRITES (WITHOUT ANY READ)
+    BufferSegmentOwner* bulkOwner = new BufferSegmentOwner(BUFFER_SEGMENT_ACCESS_LEVEL::WRITE);
+    dynBuffer->use<void>(bulkOwner, std::function<void()>([]() {}));
+    std::vector<unsigned long long> burst(10035);
+    for (unsigned long long i = 0; i < burst.size(); i++) {
+        burst[i] = i + 1;
+    }
+    auto bulkWriterTStart = std::chrono::steady_clock::now();
+    dynBuffer->write(std::span<const unsigned long long>(burst), bulkOwner);
+    auto bulkWriterTEnd = std::chrono::steady_clock::now();
+
     // auto readerTStart = std::chrono::steady_clock::now();
     // // READ TESTS
     // // ONE WAY READS
@@ -67,7 +84,9 @@ int main() {
 
     std::pair<BufferSegmentOwner*, BufferSegmentOwner*> readerWriterPair = BufferSegmentOwner::getReaderWriterPair("reader", "writer");
 
+    std::cout << "Individual Write Enqueue Time = " << std::chrono::duration<double, std::milli>(writerTEnqueued - writerTStart).count() << " ms" << std::endl;
     std::cout << "Individual Write Time = " << std::chrono::duration<double, std::milli>(writerTEnd - writerTStart).count() << " ms" << std::endl;
+    std::cout << "Bulk Write Time = " << std::chrono::duration<double, std::milli>(bulkWriterTEnd - bulkWriterTStart).count() << " ms" << std::endl;
     // std::cout << "Individual Read Time = " << std::chrono::duration<double, std::milli>(readerTEnd - readerTStart).count() << " ms" << std::endl;
 
     // Clear up before exit